@@ -43,7 +43,12 @@ SOURCES +=  \
     data_structures/segment_intersection_checker.cpp \
     data_structures/trapezoidalmap_dataset.cpp \
     drawables/drawable_trapezoidalmap_dataset.cpp \
+    gas/utils/epoch.cpp \
+    gas/utils/memory_resource.cpp \
     gas/utils/serial.cpp \
+    gas/utils/shared_mutex.cpp \
+    gas/utils/thread_pool.cpp \
+    gas/utils/tracing.cpp \
     main.cpp \
     managers/trapezoidalmap_manager.cpp \
     utils/fileutils.cpp
@@ -57,8 +62,20 @@ HEADERS += \
     drawables/drawable_trapezoidalmap_dataset.h \
     gas/data/binary_dag.hpp \
     gas/data/binary_dag.tpp \
+    gas/data/compact_trapezoidal_map.hpp \
+    gas/data/compact_trapezoidal_map.tpp \
+    gas/data/concurrent_trapezoidal_map.hpp \
+    gas/data/concurrent_trapezoidal_map.tpp \
+    gas/data/epoch_trapezoidal_map.hpp \
+    gas/data/epoch_trapezoidal_map.tpp \
+    gas/data/mirrored_trapezoidal_map.hpp \
+    gas/data/mirrored_trapezoidal_map.tpp \
     gas/data/point.hpp \
+    gas/data/rebuilding_trapezoidal_map.hpp \
+    gas/data/rebuilding_trapezoidal_map.tpp \
     gas/data/segment.hpp \
+    gas/data/snapshot_trapezoidal_map.hpp \
+    gas/data/snapshot_trapezoidal_map.tpp \
     gas/data/trapezoid.hpp \
     gas/data/trapezoid.tpp \
     gas/data/trapezoidal_dag.hpp \
@@ -66,6 +83,8 @@ HEADERS += \
     gas/data/trapezoidal_map.hpp \
     gas/data/trapezoidal_map.tpp \
     gas/data/trapezoidal_map_algorithms.tpp \
+    gas/data/trapezoidal_map_batch.hpp \
+    gas/data/trapezoidal_map_batch.tpp \
     gas/drawing/color.hpp \
     gas/drawing/trapezoid_colorizers.hpp \
     gas/drawing/trapezoid_colorizers.tpp \
@@ -75,14 +94,23 @@ HEADERS += \
     gas/drawing/trapezoidal_map_drawer.tpp \
     gas/utils/bivariant.hpp \
     gas/utils/bivariant.tpp \
+    gas/utils/chunked_storage.hpp \
+    gas/utils/chunked_storage.tpp \
+    gas/utils/epoch.hpp \
     gas/utils/geometry.hpp \
     gas/utils/geometry.tpp \
     gas/utils/intrusive_list_iterator.hpp \
     gas/utils/intrusive_list_iterator.tpp \
     gas/utils/iterators.hpp \
     gas/utils/iterators.tpp \
+    gas/utils/memory_resource.hpp \
+    gas/utils/memory_resource.tpp \
     gas/utils/parent_from_member.hpp \
     gas/utils/serial.hpp \
+    gas/utils/shared_mutex.hpp \
+    gas/utils/thread_pool.hpp \
+    gas/utils/thread_pool.tpp \
+    gas/utils/tracing.hpp \
     managers/trapezoidalmap_manager.h \
     utils/fileutils.h
 
@@ -6,6 +6,10 @@
 #define GAS_DATA_BINARY_DAG_INCLUDED
 
 #include <gas/utils/intrusive_list_iterator.hpp>
+#include <gas/utils/memory_resource.hpp>
+#include <gas/utils/thread_pool.hpp>
+#include <vector>
+#include <utility>
 
 namespace GAS
 {
@@ -34,6 +38,8 @@ namespace GAS
 			/// Intrusive linked list pointers for the other nodes in the parent Graph. 
 			Node *m_previous {}, *m_next {};
 			bool m_leaf { true };
+			/// Index of the node in the parent Graph, unique among its nodes and lower than Graph::m_nextOrdinal.
+			int m_ordinal {};
 			/// Pointers to the child nodes or intrusive linked list pointers to the other leaf nodes in the parent Graph if the node is a leaf.
 			Node *m_left {}, *m_right {};
 
@@ -125,13 +131,58 @@ namespace GAS
 		/// providing easy copy, move, deletion and iteration through all nodes or through leaves.
 		/// \tparam Data 
 		/// The data type to store in the nodes.
+		/// \remark
+		/// The nodes are allocated from a Utils::MemoryResource, which follows the graph when it is moved or swapped.
 		template<class Data>
 		class Graph
 		{
 			using Node = BDAG::Node<Data>;
 
+			/// Uninitialized node storage kept by reserve().
+			struct SpareNode
+			{
+				SpareNode *next;
+			};
+
 			Node *m_firstNode {}, *m_lastNode {}, *m_firstLeafNode {}, *m_lastLeafNode {};
 			int m_nodesCount {}, m_leafNodesCount {};
+			Utils::MemoryResource *m_resource { &Utils::newDeleteResource () };
+			SpareNode *m_spareNodes {};
+			int m_spareNodesCount {};
+			/// Ordinal of the next created node.
+			int m_nextOrdinal {};
+
+			/// Construct a node, taking its storage from the reserved ones if any.
+			/// \tparam Arguments
+			/// The Node constructor argument types.
+			/// \param[in] arguments
+			/// The Node constructor arguments.
+			/// \return
+			/// The unregistered node, with the next ordinal.
+			/// \exception std::bad_alloc
+			/// If no storage is reserved and the resource cannot allocate it.
+			template<class ... Arguments>
+			Node &newNode (Arguments &&... arguments);
+
+			/// Renumber the active nodes in list order if the ordinals have become too sparse, so that clone() needs a table proportional to the nodes.
+			/// \pre
+			/// All the nodes must be registered.
+			void compactOrdinals ();
+
+			/// Destroy a node and release its storage.
+			/// \param[in] node
+			/// The unregistered node.
+			void deleteNode (Node &node);
+
+			/// Destroy a node and release its storage or keep it for the next node creations.
+			/// \param[in] node
+			/// The unregistered node.
+			/// \param[in] release
+			/// Whether to release the storage or to add it to the reserved one.
+			void discardNode (Node &node, bool release);
+
+			/// Release the storage kept by reserve().
+			void releaseSpareNodes ();
 
 			/// Add \p node to the list of the active nodes.
 			/// \pre
@@ -179,10 +230,15 @@ namespace GAS
 			/// \copydoc ConstLeafNodeIterator
 			using LeafNodeIterator = Utils::IntrusiveListIterator<Node, &Node::m_left, &Node::m_right>;
 
-			/// Construct an empty graph.
+			/// Construct an empty graph using Utils::newDeleteResource().
 			Graph () = default;
 
-			/// Clone an existing graph.
+			/// Construct an empty graph.
+			/// \param[in] resource
+			/// The resource to allocate the nodes from.
+			explicit Graph (Utils::MemoryResource &resource);
+
+			/// Clone an existing graph using Utils::newDeleteResource().
 			/// Each Node data is copied by calling its copy constructor.
 			/// \pre 
 			/// \p Data type must be copy constructible.
@@ -191,33 +247,85 @@ namespace GAS
 			Graph (const Graph &copy);
 
 			/// Move an existing graph.
-			/// Each Node data is moved by calling its move constructor.
+			/// The nodes are not moved, so the references to them remain valid.
 			/// After calling this constructor, \p moved is empty and valid.
-			/// \pre 
-			/// \p Data type must be move constructible.
 			/// \param[in] moved 
 			/// The graph to move and clear.
-			Graph (Graph &&moved);
+			Graph (Graph &&moved) noexcept;
 
 			/// \see clear()
 			~Graph ();
 
-			/// Clear the active nodes and clone an existing graph.
-			/// Each Node data is copied by calling its copy assignment operator.
+			/// Clear the active nodes and clone an existing graph, keeping the current resource.
+			/// Each Node data is copied by calling its copy constructor.
+			/// \see clone()
 			/// \pre 
-			/// \p Data type must be copy assignable.
+			/// \p Data type must be copy constructible.
 			/// \param[in] copy
 			/// The graph to clone.
 			Graph &operator =(const Graph &copy);
 
 			/// Clear the active nodes and move an existing graph.
-			/// Each Node data is moved by calling its move assignment operator.
-			/// After calling this constructor, \p moved is empty and valid.
-			/// \pre 
-			/// \p Data type must be move assignable.
+			/// The nodes are not moved, so the references to them remain valid.
+			/// After calling this assignment operator, \p moved is empty and valid.
 			/// \param[in] moved 
 			/// The graph to move and clear.
-			Graph &operator =(Graph &&moved);
+			/// \return
+			/// This object.
+			Graph &operator =(Graph &&moved) noexcept;
+
+			/// Exchange the nodes of two graphs in constant time.
+			/// The nodes are not moved, so the references to them remain valid.
+			/// \param[in] other
+			/// The graph to swap with.
+			void swap (Graph &other) noexcept;
+
+			/// Mapping from the nodes of a graph being cloned to their clones.
+			/// \see clone()
+			class CloneMap final
+			{
+
+				friend class Graph;
+
+				/// Each node of the graph being cloned paired with its clone, indexed by the ordinal of the former.
+				const std::pair<const Node *, Node *> *m_clones;
+
+				/// \param[in] clones
+				/// The table indexed by ordinal.
+				explicit CloneMap (const std::pair<const Node *, Node *> *clones);
+
+			public:
+
+				/// \param[in] node
+				/// A node of the graph being cloned.
+				/// \return
+				/// The clone of \p node.
+				Node &operator() (const Node &node) const;
+
+			};
+
+			/// Clear the active nodes and clone an existing graph, letting the caller relocate the references stored in the node data.
+			/// Each Node data is copied by calling its copy constructor.
+			/// The clones are looked up in a table indexed by the ordinals the nodes of \p copy got on creation, so it runs in linear time.
+			/// The table is allocated from resource() and released before returning.
+			/// \tparam Relocate
+			/// The callable type, invocable with the data of a clone (<tt>Data &</tt>) and a <tt>const CloneMap &</tt>.
+			/// \pre
+			/// \p Data type must be copy constructible.
+			/// \pre
+			/// \p copy must not be this graph.
+			/// \param[in] copy
+			/// The graph to clone.
+			/// \param[in] relocate
+			/// The function to call on the data of each clone, once all the clones have been created.
+			/// \param[in] pool
+			/// The pool to run \p relocate in parallel, or \c nullptr to run it on the calling thread.
+			/// \remark
+			/// \p copy is only read, so it can be cloned by many threads at once.
+			/// \remark
+			/// If an exception is thrown, this graph is left empty.
+			template<class Relocate>
+			void clone (const Graph &copy, Relocate relocate, Utils::ThreadPool *pool = nullptr);
 
 			/// \return 
 			/// \c true if the graph is empty, \c false otherwise.
@@ -235,6 +343,23 @@ namespace GAS
 			/// The number of active (created and not yet destroyed) inner nodes.
 			int innerNodesCount () const;
 
+			/// \return
+			/// The resource the nodes are allocated from.
+			Utils::MemoryResource &resource () const;
+
+			/// Allocate storage for nodes in advance, so that the next node creations cannot fail.
+			/// \param[in] count
+			/// The number of nodes that must be creatable without allocating.
+			/// \exception std::bad_alloc
+			/// If the storage cannot be allocated. The storage allocated so far is kept.
+			/// \remark
+			/// The reserved storage is released by clear(bool) (unless asked otherwise) and by the destructor.
+			void reserve (int count);
+
+			/// \return
+			/// The number of nodes that can be created without allocating.
+			int reservedNodesCount () const;
+
 			/// Create a leaf node.
 			/// The Node data is initialized by calling its default constructor.
 			/// \pre 
@@ -335,9 +460,11 @@ namespace GAS
 			void destroyNode (Node &node);
 
 			/// Deletes all the active nodes.
+			/// \param[in] release
+			/// Whether to release the storage of the nodes and the reserved one, or to keep it all as reserved storage (see reserve()).
 			/// \remark
 			/// All the references to nodes created by this graph will be invalidated.
-			void clear ();
+			void clear (bool release = true);
 
 			/// Iterable object for iterating through the nodes.
 			/// \remark 
@@ -386,6 +513,46 @@ namespace GAS
 		template<class Data, class Walker>
 		Node<Data> &walk (Node<Data> &root, Walker walker);
 
+		/// Compute the depth of each node reachable from \p root.
+		/// The depth of a node is the length (number of edges) of the longest path from \p root to it.
+		/// \tparam Data
+		/// The Node data type.
+		/// \param[in] root
+		/// The starting node.
+		/// \return
+		/// Each node reachable from \p root (\p root included) paired with its depth, in topological order.
+		template<class Data>
+		std::vector<std::pair<const Node<Data> *, int>> getLongestPathDepths (const Node<Data> &root);
+
+		/// \tparam Data
+		/// The Node data type.
+		/// \param[in] root
+		/// The starting node.
+		/// \return
+		/// The length of the longest path from \p root to some leaf.
+		template<class Data>
+		int getMaxDepth (const Node<Data> &root);
+
+		/// \see getLongestPathDepths()
+		/// \tparam Data
+		/// The Node data type.
+		/// \param[in] root
+		/// The starting node.
+		/// \return
+		/// The number of leaves reachable from \p root for each depth, indexed by depth.
+		template<class Data>
+		std::vector<int> getLeafDepthHistogram (const Node<Data> &root);
+
+		/// Compute the leaf depth histogram from already computed depths, to avoid a second search when the depths are needed too.
+		/// \tparam Data
+		/// The Node data type.
+		/// \param[in] depths
+		/// The result of getLongestPathDepths().
+		/// \return
+		/// The number of leaves in \p depths for each depth, indexed by depth.
+		template<class Data>
+		std::vector<int> getLeafDepthHistogram (const std::vector<std::pair<const Node<Data> *, int>> &depths);
+
 	}
 
 }
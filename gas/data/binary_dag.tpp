@@ -9,7 +9,12 @@
 
 #include <cassert>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <new>
 #include <gas/utils/parent_from_member.hpp>
 
 namespace GAS
@@ -186,6 +191,87 @@ namespace GAS
 			}
 		}
 
+		template<class Data>
+		template<class ... Arguments>
+		Node<Data> &Graph<Data>::newNode (Arguments &&... _arguments)
+		{
+			void *storage;
+			if (m_spareNodes)
+			{
+				storage = m_spareNodes;
+				m_spareNodes = m_spareNodes->next;
+				m_spareNodesCount--;
+			}
+			else
+			{
+				storage = m_resource->allocate (sizeof (Node), alignof (Node));
+			}
+			Node *node;
+			try
+			{
+				node = new (storage) Node (std::forward<Arguments> (_arguments)...);
+			}
+			catch (...)
+			{
+				m_resource->deallocate (storage, sizeof (Node), alignof (Node));
+				throw;
+			}
+			node->m_ordinal = m_nextOrdinal++;
+			return *node;
+		}
+
+		template<class Data>
+		void Graph<Data>::compactOrdinals ()
+		{
+			// Renumbering takes linear time, so it must be rare enough to be amortized by the node destructions
+			if (m_nextOrdinal > 2 * m_nodesCount + 64)
+			{
+				m_nextOrdinal = 0;
+				for (Node &node : nodes ())
+				{
+					node.m_ordinal = m_nextOrdinal++;
+				}
+			}
+		}
+
+		template<class Data>
+		void Graph<Data>::deleteNode (Node &_node)
+		{
+			_node.~Node ();
+			m_resource->deallocate (&_node, sizeof (Node), alignof (Node));
+		}
+
+		template<class Data>
+		void Graph<Data>::discardNode (Node &_node, bool _release)
+		{
+			if (_release)
+			{
+				deleteNode (_node);
+			}
+			else
+			{
+				_node.~Node ();
+				m_spareNodes = new (&_node) SpareNode { m_spareNodes };
+				m_spareNodesCount++;
+			}
+		}
+
+		template<class Data>
+		void Graph<Data>::releaseSpareNodes ()
+		{
+			while (m_spareNodes)
+			{
+				SpareNode *const next { m_spareNodes->next };
+				m_resource->deallocate (m_spareNodes, sizeof (Node), alignof (Node));
+				m_spareNodes = next;
+			}
+			m_spareNodesCount = 0;
+		}
+
+		template<class Data>
+		Graph<Data>::Graph (Utils::MemoryResource &_resource) : m_resource { &_resource }
+		{}
+
 		template<class Data>
 		Graph<Data>::Graph (const Graph &_copy)
 		{
@@ -194,14 +280,18 @@ namespace GAS
 		}
 
 		template<class Data>
-		Graph<Data>::Graph (Graph &&_moved) :
+		Graph<Data>::Graph (Graph &&_moved) noexcept :
 			m_firstNode { _moved.m_firstNode }, m_lastNode { _moved.m_lastNode },
 			m_firstLeafNode { _moved.m_firstLeafNode }, m_lastLeafNode { _moved.m_lastLeafNode },
-			m_nodesCount { _moved.m_nodesCount }, m_leafNodesCount { _moved.m_leafNodesCount }
+			m_nodesCount { _moved.m_nodesCount }, m_leafNodesCount { _moved.m_leafNodesCount },
+			m_resource { _moved.m_resource }, m_spareNodes { _moved.m_spareNodes }, m_spareNodesCount { _moved.m_spareNodesCount },
+			m_nextOrdinal { _moved.m_nextOrdinal }
 		{
 			_moved.m_firstNode = _moved.m_lastNode = _moved.m_firstLeafNode = _moved.m_lastLeafNode = nullptr;
 			_moved.m_nodesCount = _moved.m_leafNodesCount = 0;
-			_moved.clear ();
+			_moved.m_spareNodes = nullptr;
+			_moved.m_spareNodesCount = 0;
+			_moved.m_nextOrdinal = 0;
 		}
 
 		template<class Data>
@@ -213,50 +303,118 @@ namespace GAS
 		template<class Data>
 		Graph<Data> &Graph<Data>::operator=(const Graph &_copy)
 		{
+			if (this != &_copy)
+			{
+				clone (_copy, [] (Data &, const CloneMap &) {});
+			}
+			return *this;
+		}
+
+		template<class Data>
+		Graph<Data>::CloneMap::CloneMap (const std::pair<const Node *, Node *> *_clones) : m_clones { _clones }
+		{}
+
+		template<class Data>
+		Node<Data> &Graph<Data>::CloneMap::operator() (const Node &_node) const
+		{
+			const std::pair<const Node *, Node *> &clone { m_clones[_node.m_ordinal] };
+			assert (clone.first == &_node);
+			return *clone.second;
+		}
+
+		template<class Data>
+		template<class Relocate>
+		void Graph<Data>::clone (const Graph &_copy, Relocate _relocate, Utils::ThreadPool *_pool)
+		{
+			assert (this != &_copy);
 			clear ();
-			std::unordered_map<const Node *, Node *> map;
-			map.reserve (_copy.nodesCount ());
-			for (const Node &node : _copy.nodes ())
-			{
-				Node &clone { *new Node { node.m_data } };
-				clone.m_leaf = node.m_leaf;
-				registerNode (clone);
-				if (clone.m_leaf)
+			// Each original paired with its clone, indexed by the ordinal of the original, with holes left by the destroyed nodes
+			Utils::ResourceVector<std::pair<const Node *, Node *>> clones { Utils::ResourceAllocator<std::pair<const Node *, Node *>> { *m_resource } };
+			try
+			{
+				clones.resize (static_cast<std::size_t>(_copy.m_nextOrdinal));
+				for (const Node &node : _copy.nodes ())
 				{
-					registerLeaf (clone);
+					Node &clone { newNode (node.m_data) };
+					clone.m_leaf = node.m_leaf;
+					clones[static_cast<std::size_t>(node.m_ordinal)] = { &node, &clone };
+				}
+				const CloneMap map { clones.data () };
+				const auto relocate = [&clones, &_relocate, &map](std::size_t _first, std::size_t _last) {
+					for (std::size_t i { _first }; i < _last; i++)
+					{
+						if (!clones[i].first)
+						{
+							continue;
+						}
+						const Node &node { *clones[i].first };
+						Node &clone { *clones[i].second };
+						if (!node.m_leaf)
+						{
+							clone.m_left = &map (*node.m_left);
+							clone.m_right = &map (*node.m_right);
+						}
+						_relocate (clone.m_data, map);
+					}
+				};
+				if (_pool)
+				{
+					Utils::parallelFor (*_pool, std::size_t {}, clones.size (), relocate);
 				}
 				else
 				{
-					clone.m_left = node.m_left;
-					clone.m_right = node.m_right;
+					relocate (0, clones.size ());
+				}
+			}
+			catch (...)
+			{
+				for (const std::pair<const Node *, Node *> &pair : clones)
+				{
+					if (pair.second)
+					{
+						deleteNode (*pair.second);
+					}
 				}
-				map.emplace (&node, &clone);
+				m_nextOrdinal = 0;
+				throw;
 			}
-			for (const std::pair<const Node *, Node *> &entry : map)
+			// Register the clones in order of ordinal, which is the order of the original list
+			for (const std::pair<const Node *, Node *> &pair : clones)
 			{
-				Node &node { *entry.second };
-				if (!node.m_leaf)
+				if (pair.second)
 				{
-					node.m_left = map.at (node.m_left);
-					node.m_right = map.at (node.m_right);
+					Node &clone { *pair.second };
+					registerNode (clone);
+					if (clone.m_leaf)
+					{
+						registerLeaf (clone);
+					}
 				}
 			}
+		}
+
+		template<class Data>
+		Graph<Data> &Graph<Data>::operator=(Graph &&_moved) noexcept
+		{
+			// The current nodes are deleted along with the temporary, and self-assignment is harmless
+			Graph moved { std::move (_moved) };
+			swap (moved);
 			return *this;
 		}
 
 		template<class Data>
-		Graph<Data> &Graph<Data>::operator=(Graph &&_moved)
+		void Graph<Data>::swap (Graph &_other) noexcept
 		{
-			clear ();
-			m_firstNode = _moved.m_firstNode;
-			m_lastNode = _moved.m_lastNode;
-			m_lastLeafNode = _moved.m_lastLeafNode;
-			m_lastLeafNode = _moved.m_lastLeafNode;
-			m_nodesCount = _moved.m_nodesCount;
-			m_leafNodesCount = _moved.m_leafNodesCount;
-			_moved.m_firstNode = _moved.m_lastNode = _moved.m_firstLeafNode = _moved.m_lastLeafNode = nullptr;
-			_moved.m_nodesCount = _moved.m_leafNodesCount = 0;
-			_moved.clear ();
+			std::swap (m_firstNode, _other.m_firstNode);
+			std::swap (m_lastNode, _other.m_lastNode);
+			std::swap (m_firstLeafNode, _other.m_firstLeafNode);
+			std::swap (m_lastLeafNode, _other.m_lastLeafNode);
+			std::swap (m_nodesCount, _other.m_nodesCount);
+			std::swap (m_leafNodesCount, _other.m_leafNodesCount);
+			std::swap (m_resource, _other.m_resource);
+			std::swap (m_spareNodes, _other.m_spareNodes);
+			std::swap (m_spareNodesCount, _other.m_spareNodesCount);
+			std::swap (m_nextOrdinal, _other.m_nextOrdinal);
 		}
 
 		template<class Data>
@@ -283,10 +441,32 @@ namespace GAS
 			return m_nodesCount - m_leafNodesCount;
 		}
 
+		template<class Data>
+		Utils::MemoryResource &Graph<Data>::resource () const
+		{
+			return *m_resource;
+		}
+
+		template<class Data>
+		void Graph<Data>::reserve (int _count)
+		{
+			while (m_spareNodesCount < _count)
+			{
+				m_spareNodes = new (m_resource->allocate (sizeof (Node), alignof (Node))) SpareNode { m_spareNodes };
+				m_spareNodesCount++;
+			}
+		}
+
+		template<class Data>
+		int Graph<Data>::reservedNodesCount () const
+		{
+			return m_spareNodesCount;
+		}
+
 		template<class Data>
 		Node<Data> &Graph<Data>::createLeaf ()
 		{
-			Node &node { *new Node };
+			Node &node { newNode () };
 			registerNode (node);
 			registerLeaf (node);
 			return node;
@@ -295,7 +475,7 @@ namespace GAS
 		template<class Data>
 		Node<Data> &Graph<Data>::createLeaf (const Data &_data)
 		{
-			Node &node { *new Node { _data } };
+			Node &node { newNode (_data) };
 			registerNode (node);
 			registerLeaf (node);
 			return node;
@@ -304,7 +484,7 @@ namespace GAS
 		template<class Data>
 		Node<Data> &Graph<Data>::createLeaf (Data &&_data)
 		{
-			Node &node { *new Node { std::move (_data) } };
+			Node &node { newNode (std::move (_data)) };
 			registerNode (node);
 			registerLeaf (node);
 			return node;
@@ -313,7 +493,7 @@ namespace GAS
 		template<class Data>
 		Node<Data> &Graph<Data>::createInner (Node &_left, Node &_right)
 		{
-			Node &node { *new Node };
+			Node &node { newNode () };
 			node.m_left = &_left;
 			node.m_right = &_right;
 			node.m_leaf = false;
@@ -324,7 +504,7 @@ namespace GAS
 		template<class Data>
 		Node<Data> &Graph<Data>::createInner (const Data &_data, Node &_left, Node &_right)
 		{
-			Node &node { *new Node { _data } };
+			Node &node { newNode (_data) };
 			node.m_left = &_left;
 			node.m_right = &_right;
 			node.m_leaf = false;
@@ -335,7 +515,7 @@ namespace GAS
 		template<class Data>
 		Node<Data> &Graph<Data>::createInner (Data &&_data, Node &_left, Node &_right)
 		{
-			Node &node { *new Node { std::move (_data) } };
+			Node &node { newNode (std::move (_data)) };
 			node.m_left = &_left;
 			node.m_right = &_right;
 			node.m_leaf = false;
@@ -373,11 +553,12 @@ namespace GAS
 			{
 				unregisterLeaf (_node);
 			}
-			delete &_node;
+			deleteNode (_node);
+			compactOrdinals ();
 		}
 
 		template<class Data>
-		void Graph<Data>::clear ()
+		void Graph<Data>::clear (bool _release)
 		{
 			if (!isEmpty ())
 			{
@@ -385,37 +566,45 @@ namespace GAS
 				Node *lastNode {};
 				for (Node &node : nodes ())
 				{
-					delete lastNode;
+					if (lastNode)
+					{
+						discardNode (*lastNode, _release);
+					}
 					lastNode = &node;
 				}
-				delete lastNode;
+				discardNode (*lastNode, _release);
 			}
 			m_firstNode = m_lastNode = m_firstLeafNode = m_lastLeafNode = nullptr;
-			m_nodesCount = m_leafNodesCount = 0;
+			m_nodesCount = m_leafNodesCount = m_nextOrdinal = 0;
+			if (_release)
+			{
+				releaseSpareNodes ();
+			}
 		}
 
 		template<class Data>
 		typename Graph<Data>::ConstNodeIterator::Iterable Graph<Data>::nodes () const
 		{
-			return typename ConstNodeIterator::Iterable { *m_firstNode };
+			// An empty graph has no first node to refer to, so the iterators must not dereference it
+			return typename ConstNodeIterator::Iterable { m_firstNode ? ConstNodeIterator { *m_firstNode } : ConstNodeIterator {} };
 		}
 
 		template<class Data>
 		typename Graph<Data>::NodeIterator::Iterable Graph<Data>::nodes ()
 		{
-			return typename NodeIterator::Iterable { *m_firstNode };
+			return typename NodeIterator::Iterable { m_firstNode ? NodeIterator { *m_firstNode } : NodeIterator {} };
 		}
 
 		template<class Data>
 		typename Graph<Data>::ConstLeafNodeIterator::Iterable Graph<Data>::leafNodes () const
 		{
-			return typename ConstLeafNodeIterator::Iterable { *m_firstLeafNode };
+			return typename ConstLeafNodeIterator::Iterable { m_firstLeafNode ? ConstLeafNodeIterator { *m_firstLeafNode } : ConstLeafNodeIterator {} };
 		}
 
 		template<class Data>
 		typename Graph<Data>::LeafNodeIterator::Iterable Graph<Data>::leafNodes ()
 		{
-			return typename LeafNodeIterator::Iterable { *m_firstLeafNode };
+			return typename LeafNodeIterator::Iterable { m_firstLeafNode ? LeafNodeIterator { *m_firstLeafNode } : LeafNodeIterator {} };
 		}
 
 		template<class Data, class Walker>
@@ -446,6 +635,91 @@ namespace GAS
 			return const_cast<Node<Data> &>(walk (static_cast<const Node<Data> &>(_root), _walker));
 		}
 
+		template<class Data>
+		std::vector<std::pair<const Node<Data> *, int>> getLongestPathDepths (const Node<Data> &_root)
+		{
+			// Iterative depth-first search (the graph may be deep) to sort the nodes topologically
+			std::vector<const Node<Data> *> postOrder;
+			{
+				std::unordered_set<const Node<Data> *> visited;
+				std::vector<std::pair<const Node<Data> *, bool>> stack { { &_root, false } };
+				while (!stack.empty ())
+				{
+					const std::pair<const Node<Data> *, bool> entry { stack.back () };
+					stack.pop_back ();
+					const Node<Data> &node { *entry.first };
+					if (entry.second)
+					{
+						postOrder.push_back (&node);
+					}
+					else if (visited.insert (&node).second)
+					{
+						stack.emplace_back (&node, true);
+						if (!node.isLeaf ())
+						{
+							stack.emplace_back (&node.right (), false);
+							stack.emplace_back (&node.left (), false);
+						}
+					}
+				}
+			}
+			// Relax the depths following the topological order
+			std::unordered_map<const Node<Data> *, int> depths;
+			depths.reserve (postOrder.size ());
+			depths[&_root] = 0;
+			std::vector<std::pair<const Node<Data> *, int>> result;
+			result.reserve (postOrder.size ());
+			for (std::size_t i { postOrder.size () }; i-- > 0;)
+			{
+				const Node<Data> &node { *postOrder[i] };
+				const int depth { depths[&node] };
+				if (!node.isLeaf ())
+				{
+					int &left { depths[&node.left ()] }, &right { depths[&node.right ()] };
+					left = std::max (left, depth + 1);
+					right = std::max (right, depth + 1);
+				}
+				result.emplace_back (&node, depth);
+			}
+			return result;
+		}
+
+		template<class Data>
+		int getMaxDepth (const Node<Data> &_root)
+		{
+			// The deepest node is always a leaf
+			int maxDepth {};
+			for (const std::pair<const Node<Data> *, int> &entry : getLongestPathDepths (_root))
+			{
+				maxDepth = std::max (maxDepth, entry.second);
+			}
+			return maxDepth;
+		}
+
+		template<class Data>
+		std::vector<int> getLeafDepthHistogram (const Node<Data> &_root)
+		{
+			return getLeafDepthHistogram (getLongestPathDepths (_root));
+		}
+
+		template<class Data>
+		std::vector<int> getLeafDepthHistogram (const std::vector<std::pair<const Node<Data> *, int>> &_depths)
+		{
+			std::vector<int> histogram;
+			for (const std::pair<const Node<Data> *, int> &entry : _depths)
+			{
+				if (entry.first->isLeaf ())
+				{
+					if (entry.second >= static_cast<int>(histogram.size ()))
+					{
+						histogram.resize (entry.second + 1);
+					}
+					histogram[entry.second]++;
+				}
+			}
+			return histogram;
+		}
+
 	}
 
 }
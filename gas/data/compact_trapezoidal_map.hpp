@@ -0,0 +1,318 @@
+/// GAS::CompactTrapezoidalMap index-based snapshot of a GAS::TrapezoidalMap.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_DATA_COMPACT_TRAPEZOIDAL_MAP_INCLUDED
+#define GAS_DATA_COMPACT_TRAPEZOIDAL_MAP_INCLUDED
+
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <gas/utils/memory_resource.hpp>
+#include <gas/utils/tracing.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace GAS
+{
+
+	/// Read-only snapshot of a TrapezoidalMap that stores points, segments, trapezoids and search structure nodes in plain arrays,
+	/// linked together through 32-bit indices instead of pointers.
+	/// Each trapezoid takes 32 bytes and the whole snapshot can be copied, moved or serialized as raw arrays.
+	/// \tparam Scalar
+	/// The scalar type.
+	/// \remark
+	/// The snapshot does not depend on the source map, which can be modified or destroyed after the construction.
+	/// \remark
+	/// The arrays are allocated from the Utils::MemoryResource passed to the constructor, while the lookup tables used to build them are temporary.
+	template<class Scalar>
+	class CompactTrapezoidalMap final
+	{
+
+		using PointS = Point<Scalar>;
+		using SegmentS = Segment<Scalar>;
+
+	public:
+
+		/// Index type.
+		using Index = std::uint32_t;
+
+		/// Null index, used for missing neighbors.
+		static constexpr Index null { 0xFFFFFFFF };
+
+		/// Trapezoid record.
+		struct TrapezoidRecord
+		{
+			Index left, right;													///< Point indices.
+			Index bottom, top;													///< Segment indices.
+			Index lowerLeftNeighbor, upperLeftNeighbor;							///< Trapezoid indices or #null.
+			Index lowerRightNeighbor, upperRightNeighbor;						///< Trapezoid indices or #null.
+		};
+
+		/// Search structure node type.
+		enum class ENodeType : std::uint32_t
+		{
+			Leaf,			///< The node data is a trapezoid index.
+			Vertical,		///< The node data is an index into the split x-coordinate array.
+			NonVertical		///< The node data is a segment index whose line splits the plane.
+		};
+
+		/// Search structure node record.
+		struct NodeRecord
+		{
+			ENodeType type;		///< Node type.
+			Index data;			///< Trapezoid, x-coordinate or segment index depending on #type.
+			Index left, right;	///< Child node indices, or #null for leaves.
+		};
+
+		/// Lightweight trapezoid accessor with the same read-only interface of GAS::Trapezoid.
+		class Trapezoid final
+		{
+
+			friend class CompactTrapezoidalMap;
+
+			const CompactTrapezoidalMap *m_map {};
+			Index m_index { null };
+
+			Trapezoid (const CompactTrapezoidalMap &map, Index index);
+
+			const TrapezoidRecord &record () const;
+
+			Trapezoid neighbor (Index index) const;
+
+		public:
+
+			/// Construct a null trapezoid.
+			Trapezoid () = default;
+
+			/// \return
+			/// \c true if the trapezoid refers to an actual trapezoid, \c false otherwise.
+			explicit operator bool () const;
+
+			/// \return
+			/// \c true if the two accessors refer to the same trapezoid, \c false otherwise.
+			bool operator==(const Trapezoid &other) const;
+
+			/// \return
+			/// \c true if the two accessors do not refer to the same trapezoid, \c false otherwise.
+			bool operator!=(const Trapezoid &other) const;
+
+			/// \return
+			/// The trapezoid index in the snapshot, stable for the snapshot lifetime.
+			Index index () const;
+
+			/// \return
+			/// The left point.
+			const PointS *left () const;
+
+			/// \return
+			/// The right point.
+			const PointS *right () const;
+
+			/// \return
+			/// The bottom segment.
+			const SegmentS *bottom () const;
+
+			/// \return
+			/// The top segment.
+			const SegmentS *top () const;
+
+			/// \return
+			/// The x-coordinate of the left point.
+			Scalar leftX () const;
+
+			/// \return
+			/// The x-coordinate of the right point.
+			Scalar rightX () const;
+
+			/// \return
+			/// The lower left neighbor or a null trapezoid.
+			Trapezoid lowerLeftNeighbor () const;
+
+			/// \return
+			/// The upper left neighbor or a null trapezoid.
+			Trapezoid upperLeftNeighbor () const;
+
+			/// \return
+			/// The lower right neighbor or a null trapezoid.
+			Trapezoid lowerRightNeighbor () const;
+
+			/// \return
+			/// The upper right neighbor or a null trapezoid.
+			Trapezoid upperRightNeighbor () const;
+
+			/// \see GAS::Trapezoid::bottomLeft()
+			template<class OutputScalar = Scalar>
+			Point<OutputScalar> bottomLeft () const;
+
+			/// \see GAS::Trapezoid::bottomRight()
+			template<class OutputScalar = Scalar>
+			Point<OutputScalar> bottomRight () const;
+
+			/// \see GAS::Trapezoid::topLeft()
+			template<class OutputScalar = Scalar>
+			Point<OutputScalar> topLeft () const;
+
+			/// \see GAS::Trapezoid::topRight()
+			template<class OutputScalar = Scalar>
+			Point<OutputScalar> topRight () const;
+
+			/// \see GAS::Trapezoid::centroid()
+			template<class OutputScalar = Scalar>
+			Point<OutputScalar> centroid () const;
+
+			/// \see GAS::Trapezoid::width()
+			Scalar width () const;
+
+			/// \see GAS::Trapezoid::area()
+			template<class OutputScalar = Scalar>
+			OutputScalar area () const;
+
+			/// \see GAS::Trapezoid::contains()
+			template<class InputScalar = Scalar>
+			bool contains (const Point<InputScalar> &point) const;
+
+			/// \see GAS::Trapezoid::isJointLeft()
+			bool isJointLeft () const;
+
+			/// \see GAS::Trapezoid::isJointRight()
+			bool isJointRight () const;
+
+		};
+
+		/// Forward iterator over the trapezoids of a CompactTrapezoidalMap.
+		class ConstIterator final
+		{
+
+			friend class CompactTrapezoidalMap;
+
+			Trapezoid m_trapezoid;
+
+			ConstIterator (const CompactTrapezoidalMap &map, Index index);
+
+		public:
+
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = Trapezoid;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const Trapezoid *;
+			using reference = const Trapezoid &;
+
+			/// Construct a singular iterator.
+			ConstIterator () = default;
+
+			ConstIterator &operator++();
+			ConstIterator operator++(int);
+
+			bool operator==(const ConstIterator &other) const;
+			bool operator!=(const ConstIterator &other) const;
+
+			const Trapezoid &operator*() const;
+			const Trapezoid *operator->() const;
+
+		};
+
+	private:
+
+		PointS m_bottomLeft, m_topRight;
+		Utils::ResourceVector<PointS> m_points;
+		Utils::ResourceVector<SegmentS> m_segments;
+		Utils::ResourceVector<Scalar> m_xs;
+		Utils::ResourceVector<TrapezoidRecord> m_trapezoids;
+		Utils::ResourceVector<NodeRecord> m_nodes;
+
+	public:
+
+		/// Construct a snapshot of a trapezoidal map.
+		/// \param[in] map
+		/// The trapezoidal map to copy.
+		/// \param[in] resource
+		/// The resource to allocate the arrays from. It must outlive the snapshot.
+		/// \exception std::length_error
+		/// If \p map has too many elements to be indexed with #Index.
+		/// \exception std::logic_error
+		/// If \p map has been moved and not modified since, so that it has no trapezoids.
+		explicit CompactTrapezoidalMap (const TrapezoidalMap<Scalar> &map, Utils::MemoryResource &resource = Utils::newDeleteResource ());
+
+		/// \return
+		/// The bottom left point of the bounding box.
+		const PointS &bottomLeft () const;
+
+		/// \return
+		/// The top right point of the bounding box.
+		const PointS &topRight () const;
+
+		/// Check if a point is inside the map bounds.
+		/// \return
+		/// \c true if \p point is inside bounds, \c false otherwise.
+		bool isPointInsideBounds (const PointS &point) const;
+
+		/// Find the trapezoid that contains a point.
+		/// \tparam QueryScalar
+		/// The scalar type of the query point.
+		/// \param[in] point
+		/// The query point.
+		/// \return
+		/// The trapezoid containing \p point, disambiguated as TrapezoidalMap::query() does.
+		/// \exception std::invalid_argument
+		/// If \p point is not inside bounds.
+		template<class QueryScalar = Scalar>
+		Trapezoid query (const Point<QueryScalar> &point) const;
+
+		/// \return
+		/// The number of trapezoids.
+		int trapezoidsCount () const;
+
+		/// \return
+		/// The number of segments, including the two bounding segments.
+		int segmentsCount () const;
+
+		/// \param[in] index
+		/// The trapezoid index.
+		/// \pre
+		/// \p index must be less than trapezoidsCount().
+		/// \return
+		/// The trapezoid at \p index.
+		Trapezoid trapezoid (Index index) const;
+
+		/// \return
+		/// The point array.
+		const Utils::ResourceVector<PointS> &points () const;
+
+		/// \return
+		/// The segment array.
+		const Utils::ResourceVector<SegmentS> &segments () const;
+
+		/// \return
+		/// The vertical split x-coordinate array.
+		const Utils::ResourceVector<Scalar> &splitXs () const;
+
+		/// \return
+		/// The trapezoid record array.
+		const Utils::ResourceVector<TrapezoidRecord> &trapezoidRecords () const;
+
+		/// \return
+		/// The search structure node array. The root is the first node.
+		const Utils::ResourceVector<NodeRecord> &nodeRecords () const;
+
+		/// \return
+		/// The number of bytes used by the arrays.
+		std::size_t memoryUsage () const;
+
+		/// \return
+		/// The \c begin iterator of the trapezoids.
+		ConstIterator begin () const;
+
+		/// \return
+		/// The \c end iterator of the trapezoids.
+		ConstIterator end () const;
+
+	};
+
+}
+
+#include "compact_trapezoidal_map.tpp"
+
+#endif
@@ -0,0 +1,461 @@
+#ifndef GAS_DATA_COMPACT_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+#define GAS_DATA_COMPACT_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+
+#ifndef GAS_DATA_COMPACT_TRAPEZOIDAL_MAP_INCLUDED
+#error 'gas/data/compact_trapezoidal_map.tpp' should not be directly included
+#endif
+
+#include "compact_trapezoidal_map.hpp"
+
+#include <stdexcept>
+#include <cassert>
+#include <limits>
+#include <unordered_map>
+#include <gas/utils/geometry.hpp>
+
+namespace GAS
+{
+
+	template<class Scalar>
+	constexpr typename CompactTrapezoidalMap<Scalar>::Index CompactTrapezoidalMap<Scalar>::null;
+
+	template<class Scalar>
+	CompactTrapezoidalMap<Scalar>::Trapezoid::Trapezoid (const CompactTrapezoidalMap &_map, Index _index) : m_map { &_map }, m_index { _index }
+	{}
+
+	template<class Scalar>
+	const typename CompactTrapezoidalMap<Scalar>::TrapezoidRecord &CompactTrapezoidalMap<Scalar>::Trapezoid::record () const
+	{
+		assert (m_map && m_index < m_map->m_trapezoids.size ());
+		return m_map->m_trapezoids[m_index];
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::Trapezoid CompactTrapezoidalMap<Scalar>::Trapezoid::neighbor (Index _index) const
+	{
+		return _index == null ? Trapezoid {} : Trapezoid { *m_map, _index };
+	}
+
+	template<class Scalar>
+	CompactTrapezoidalMap<Scalar>::Trapezoid::operator bool () const
+	{
+		return m_index != null;
+	}
+
+	template<class Scalar>
+	bool CompactTrapezoidalMap<Scalar>::Trapezoid::operator==(const Trapezoid &_other) const
+	{
+		return m_index == _other.m_index && (m_index == null || m_map == _other.m_map);
+	}
+
+	template<class Scalar>
+	bool CompactTrapezoidalMap<Scalar>::Trapezoid::operator!=(const Trapezoid &_other) const
+	{
+		return !(*this == _other);
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::Index CompactTrapezoidalMap<Scalar>::Trapezoid::index () const
+	{
+		return m_index;
+	}
+
+	template<class Scalar>
+	const Point<Scalar> *CompactTrapezoidalMap<Scalar>::Trapezoid::left () const
+	{
+		return &m_map->m_points[record ().left];
+	}
+
+	template<class Scalar>
+	const Point<Scalar> *CompactTrapezoidalMap<Scalar>::Trapezoid::right () const
+	{
+		return &m_map->m_points[record ().right];
+	}
+
+	template<class Scalar>
+	const Segment<Scalar> *CompactTrapezoidalMap<Scalar>::Trapezoid::bottom () const
+	{
+		return &m_map->m_segments[record ().bottom];
+	}
+
+	template<class Scalar>
+	const Segment<Scalar> *CompactTrapezoidalMap<Scalar>::Trapezoid::top () const
+	{
+		return &m_map->m_segments[record ().top];
+	}
+
+	template<class Scalar>
+	Scalar CompactTrapezoidalMap<Scalar>::Trapezoid::leftX () const
+	{
+		return left ()->x ();
+	}
+
+	template<class Scalar>
+	Scalar CompactTrapezoidalMap<Scalar>::Trapezoid::rightX () const
+	{
+		return right ()->x ();
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::Trapezoid CompactTrapezoidalMap<Scalar>::Trapezoid::lowerLeftNeighbor () const
+	{
+		return neighbor (record ().lowerLeftNeighbor);
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::Trapezoid CompactTrapezoidalMap<Scalar>::Trapezoid::upperLeftNeighbor () const
+	{
+		return neighbor (record ().upperLeftNeighbor);
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::Trapezoid CompactTrapezoidalMap<Scalar>::Trapezoid::lowerRightNeighbor () const
+	{
+		return neighbor (record ().lowerRightNeighbor);
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::Trapezoid CompactTrapezoidalMap<Scalar>::Trapezoid::upperRightNeighbor () const
+	{
+		return neighbor (record ().upperRightNeighbor);
+	}
+
+	template<class Scalar>
+	template<class OutputScalar>
+	Point<OutputScalar> CompactTrapezoidalMap<Scalar>::Trapezoid::bottomLeft () const
+	{
+		return Geometry::getPointOnLine<OutputScalar> (*bottom (), leftX ());
+	}
+
+	template<class Scalar>
+	template<class OutputScalar>
+	Point<OutputScalar> CompactTrapezoidalMap<Scalar>::Trapezoid::bottomRight () const
+	{
+		return Geometry::getPointOnLine<OutputScalar> (*bottom (), rightX ());
+	}
+
+	template<class Scalar>
+	template<class OutputScalar>
+	Point<OutputScalar> CompactTrapezoidalMap<Scalar>::Trapezoid::topLeft () const
+	{
+		return Geometry::getPointOnLine<OutputScalar> (*top (), leftX ());
+	}
+
+	template<class Scalar>
+	template<class OutputScalar>
+	Point<OutputScalar> CompactTrapezoidalMap<Scalar>::Trapezoid::topRight () const
+	{
+		return Geometry::getPointOnLine<OutputScalar> (*top (), rightX ());
+	}
+
+	template<class Scalar>
+	template<class OutputScalar>
+	Point<OutputScalar> CompactTrapezoidalMap<Scalar>::Trapezoid::centroid () const
+	{
+		return Geometry::getTrapezoidCentroid<OutputScalar> (*left (), *right (), *bottom (), *top ());
+	}
+
+	template<class Scalar>
+	Scalar CompactTrapezoidalMap<Scalar>::Trapezoid::width () const
+	{
+		return rightX () - leftX ();
+	}
+
+	template<class Scalar>
+	template<class OutputScalar>
+	OutputScalar CompactTrapezoidalMap<Scalar>::Trapezoid::area () const
+	{
+		return Geometry::getTrapezoidArea<OutputScalar> (*left (), *right (), *bottom (), *top ());
+	}
+
+	template<class Scalar>
+	template<class InputScalar>
+	bool CompactTrapezoidalMap<Scalar>::Trapezoid::contains (const Point<InputScalar> &_point) const
+	{
+		return Geometry::isPointInsideTrapezoid (_point, *left (), *right (), *bottom (), *top ());
+	}
+
+	template<class Scalar>
+	bool CompactTrapezoidalMap<Scalar>::Trapezoid::isJointLeft () const
+	{
+		return Geometry::isTrapezoidJointLeft (*left (), *bottom (), *top ());
+	}
+
+	template<class Scalar>
+	bool CompactTrapezoidalMap<Scalar>::Trapezoid::isJointRight () const
+	{
+		return Geometry::isTrapezoidJointRight (*right (), *bottom (), *top ());
+	}
+
+	template<class Scalar>
+	CompactTrapezoidalMap<Scalar>::ConstIterator::ConstIterator (const CompactTrapezoidalMap &_map, Index _index) : m_trapezoid { _map, _index }
+	{}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::ConstIterator &CompactTrapezoidalMap<Scalar>::ConstIterator::operator++()
+	{
+		m_trapezoid.m_index++;
+		return *this;
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::ConstIterator CompactTrapezoidalMap<Scalar>::ConstIterator::operator++(int)
+	{
+		ConstIterator before { *this };
+		++ *this;
+		return before;
+	}
+
+	template<class Scalar>
+	bool CompactTrapezoidalMap<Scalar>::ConstIterator::operator==(const ConstIterator &_other) const
+	{
+		return m_trapezoid.m_map == _other.m_trapezoid.m_map && m_trapezoid.m_index == _other.m_trapezoid.m_index;
+	}
+
+	template<class Scalar>
+	bool CompactTrapezoidalMap<Scalar>::ConstIterator::operator!=(const ConstIterator &_other) const
+	{
+		return !(*this == _other);
+	}
+
+	template<class Scalar>
+	const typename CompactTrapezoidalMap<Scalar>::Trapezoid &CompactTrapezoidalMap<Scalar>::ConstIterator::operator*() const
+	{
+		return m_trapezoid;
+	}
+
+	template<class Scalar>
+	const typename CompactTrapezoidalMap<Scalar>::Trapezoid *CompactTrapezoidalMap<Scalar>::ConstIterator::operator->() const
+	{
+		return &m_trapezoid;
+	}
+
+	template<class Scalar>
+	CompactTrapezoidalMap<Scalar>::CompactTrapezoidalMap (const TrapezoidalMap<Scalar> &_map, Utils::MemoryResource &_resource)
+		: m_bottomLeft { _map.bottomLeft () }, m_topRight { _map.topRight () },
+		m_points (Utils::ResourceAllocator<PointS> { _resource }), m_segments (Utils::ResourceAllocator<SegmentS> { _resource }), m_xs (Utils::ResourceAllocator<Scalar> { _resource }),
+		m_trapezoids (Utils::ResourceAllocator<TrapezoidRecord> { _resource }), m_nodes (Utils::ResourceAllocator<NodeRecord> { _resource })
+	{
+		using LiveTrapezoid = GAS::Trapezoid<Scalar>;
+		using LiveNode = TDAG::Node<Scalar>;
+		// Index 'null' is reserved
+		const std::size_t maxSize { std::numeric_limits<Index>::max () };
+		const auto checkSize = [maxSize](std::size_t _size) {
+			if (_size >= maxSize)
+			{
+				throw std::length_error ("Trapezoidal map is too big to be indexed");
+			}
+			return static_cast<Index>(_size);
+		};
+		// Points and segments are collected on first use
+		std::unordered_map<const PointS *, Index> pointIndices;
+		std::unordered_map<const SegmentS *, Index> segmentIndices;
+		const auto getPointIndex = [&](const PointS *_point) {
+			const std::pair<typename std::unordered_map<const PointS *, Index>::iterator, bool> entry { pointIndices.emplace (_point, checkSize (m_points.size ())) };
+			if (entry.second)
+			{
+				m_points.push_back (*_point);
+			}
+			return entry.first->second;
+		};
+		const auto getSegmentIndex = [&](const SegmentS *_segment) {
+			const std::pair<typename std::unordered_map<const SegmentS *, Index>::iterator, bool> entry { segmentIndices.emplace (_segment, checkSize (m_segments.size ())) };
+			if (entry.second)
+			{
+				m_segments.push_back (*_segment);
+			}
+			return entry.first->second;
+		};
+		// Trapezoids
+		std::unordered_map<const LiveTrapezoid *, Index> trapezoidIndices;
+		for (const LiveTrapezoid &trapezoid : _map)
+		{
+			trapezoidIndices.emplace (&trapezoid, checkSize (trapezoidIndices.size ()));
+		}
+		const auto getTrapezoidIndex = [&](const LiveTrapezoid *_trapezoid) {
+			return _trapezoid ? trapezoidIndices.at (_trapezoid) : null;
+		};
+		m_trapezoids.resize (trapezoidIndices.size ());
+		for (const LiveTrapezoid &trapezoid : _map)
+		{
+			TrapezoidRecord &record { m_trapezoids[trapezoidIndices.at (&trapezoid)] };
+			record.left = getPointIndex (trapezoid.left ());
+			record.right = getPointIndex (trapezoid.right ());
+			record.bottom = getSegmentIndex (trapezoid.bottom ());
+			record.top = getSegmentIndex (trapezoid.top ());
+			record.lowerLeftNeighbor = getTrapezoidIndex (trapezoid.lowerLeftNeighbor ());
+			record.upperLeftNeighbor = getTrapezoidIndex (trapezoid.upperLeftNeighbor ());
+			record.lowerRightNeighbor = getTrapezoidIndex (trapezoid.lowerRightNeighbor ());
+			record.upperRightNeighbor = getTrapezoidIndex (trapezoid.upperRightNeighbor ());
+		}
+		// Search structure nodes in depth-first order, starting from the root
+		std::unordered_map<const LiveNode *, Index> nodeIndices;
+		std::vector<const LiveNode *> order, stack { &_map.root () };
+		while (!stack.empty ())
+		{
+			const LiveNode &node { *stack.back () };
+			stack.pop_back ();
+			if (nodeIndices.emplace (&node, checkSize (order.size ())).second)
+			{
+				order.push_back (&node);
+				if (!node.isLeaf ())
+				{
+					stack.push_back (&node.right ());
+					stack.push_back (&node.left ());
+				}
+			}
+		}
+		m_nodes.reserve (order.size ());
+		for (const LiveNode *node : order)
+		{
+			NodeRecord record;
+			if (node->isLeaf ())
+			{
+				record.type = ENodeType::Leaf;
+				record.data = trapezoidIndices.at (&node->data ().second ());
+				record.left = record.right = null;
+			}
+			else
+			{
+				const TDAG::Split<Scalar> &split { node->data ().first () };
+				switch (split.type ())
+				{
+					default:
+						assert (false);
+					case TDAG::ESplitType::Vertical:
+						record.type = ENodeType::Vertical;
+						record.data = checkSize (m_xs.size ());
+						m_xs.push_back (split.x ());
+						break;
+					case TDAG::ESplitType::NonVertical:
+						record.type = ENodeType::NonVertical;
+						record.data = getSegmentIndex (&split.segment ());
+						break;
+				}
+				record.left = nodeIndices.at (&node->left ());
+				record.right = nodeIndices.at (&node->right ());
+			}
+			m_nodes.push_back (record);
+		}
+	}
+
+	template<class Scalar>
+	const Point<Scalar> &CompactTrapezoidalMap<Scalar>::bottomLeft () const
+	{
+		return m_bottomLeft;
+	}
+
+	template<class Scalar>
+	const Point<Scalar> &CompactTrapezoidalMap<Scalar>::topRight () const
+	{
+		return m_topRight;
+	}
+
+	template<class Scalar>
+	bool CompactTrapezoidalMap<Scalar>::isPointInsideBounds (const PointS &_point) const
+	{
+		return Geometry::isPointInsideBox (_point, m_bottomLeft, m_topRight);
+	}
+
+	template<class Scalar>
+	template<class QueryScalar>
+	typename CompactTrapezoidalMap<Scalar>::Trapezoid CompactTrapezoidalMap<Scalar>::query (const Point<QueryScalar> &_point) const
+	{
+		GAS_UTILS_TRACE_SPAN ("CompactTrapezoidalMap::query");
+		if (!isPointInsideBounds (Geometry::cast<Scalar> (_point)))
+		{
+			throw std::invalid_argument ("Point is outside bounds");
+		}
+		const NodeRecord *node { &m_nodes.front () };
+		while (node->type != ENodeType::Leaf)
+		{
+			Geometry::ESide side;
+			if (node->type == ENodeType::Vertical)
+			{
+				side = Geometry::getPointSideWithVerticalLine (static_cast<QueryScalar>(m_xs[node->data]), _point);
+			}
+			else
+			{
+				side = Geometry::getPointSideWithSegment (Geometry::cast<QueryScalar> (m_segments[node->data]), _point);
+			}
+			// Always disambiguate to the right as TDAG::query does
+			node = &m_nodes[side == Geometry::ESide::Left ? node->left : node->right];
+		}
+		return Trapezoid { *this, node->data };
+	}
+
+	template<class Scalar>
+	int CompactTrapezoidalMap<Scalar>::trapezoidsCount () const
+	{
+		return static_cast<int>(m_trapezoids.size ());
+	}
+
+	template<class Scalar>
+	int CompactTrapezoidalMap<Scalar>::segmentsCount () const
+	{
+		return static_cast<int>(m_segments.size ());
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::Trapezoid CompactTrapezoidalMap<Scalar>::trapezoid (Index _index) const
+	{
+		assert (_index < m_trapezoids.size ());
+		return Trapezoid { *this, _index };
+	}
+
+	template<class Scalar>
+	const Utils::ResourceVector<Point<Scalar>> &CompactTrapezoidalMap<Scalar>::points () const
+	{
+		return m_points;
+	}
+
+	template<class Scalar>
+	const Utils::ResourceVector<Segment<Scalar>> &CompactTrapezoidalMap<Scalar>::segments () const
+	{
+		return m_segments;
+	}
+
+	template<class Scalar>
+	const Utils::ResourceVector<Scalar> &CompactTrapezoidalMap<Scalar>::splitXs () const
+	{
+		return m_xs;
+	}
+
+	template<class Scalar>
+	const Utils::ResourceVector<typename CompactTrapezoidalMap<Scalar>::TrapezoidRecord> &CompactTrapezoidalMap<Scalar>::trapezoidRecords () const
+	{
+		return m_trapezoids;
+	}
+
+	template<class Scalar>
+	const Utils::ResourceVector<typename CompactTrapezoidalMap<Scalar>::NodeRecord> &CompactTrapezoidalMap<Scalar>::nodeRecords () const
+	{
+		return m_nodes;
+	}
+
+	template<class Scalar>
+	std::size_t CompactTrapezoidalMap<Scalar>::memoryUsage () const
+	{
+		return sizeof (CompactTrapezoidalMap)
+			+ m_points.capacity () * sizeof (PointS)
+			+ m_segments.capacity () * sizeof (SegmentS)
+			+ m_xs.capacity () * sizeof (Scalar)
+			+ m_trapezoids.capacity () * sizeof (TrapezoidRecord)
+			+ m_nodes.capacity () * sizeof (NodeRecord);
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::ConstIterator CompactTrapezoidalMap<Scalar>::begin () const
+	{
+		return ConstIterator { *this, 0 };
+	}
+
+	template<class Scalar>
+	typename CompactTrapezoidalMap<Scalar>::ConstIterator CompactTrapezoidalMap<Scalar>::end () const
+	{
+		return ConstIterator { *this, static_cast<Index>(m_trapezoids.size ()) };
+	}
+
+}
+
+#endif
@@ -0,0 +1,130 @@
+/// GAS::ConcurrentTrapezoidalMap multiple-writer wrapper of GAS::TrapezoidalMap.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_DATA_CONCURRENT_TRAPEZOIDAL_MAP_INCLUDED
+#define GAS_DATA_CONCURRENT_TRAPEZOIDAL_MAP_INCLUDED
+
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <gas/utils/shared_mutex.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace GAS
+{
+
+	/// Trapezoidal map that many threads can add segments to at once.
+	/// Insertions are optimistic: the segments are validated and located concurrently against the current map under a shared lock,
+	/// then the valid ones are added under an exclusive lock, reusing the located trapezoids if none of them has been split in the meantime. A validation is still sound if no segment added in the meantime
+	/// overlaps the x-interval of the validated segment, since the validity of a segment only depends on the segments sharing some x-coordinate with it.
+	/// Conflicting segments are validated again while adding them. Rejections are never repeated, since a rejected segment stays rejected as the map grows.
+	/// \tparam Scalar
+	/// The scalar type.
+	/// \remark
+	/// All the methods can be called concurrently, unless #GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS is defined.
+	/// The result is the same as adding the accepted segments sequentially in the order in which they have been added.
+	/// \note
+	/// The search structure is updated in place and its nodes have many parents, so locking only the crossed trapezoids and their leaves
+	/// would not protect the concurrent descents. Only the validation, the descent and the chain walk run in parallel, while the structural
+	/// updates are serialized. Accepted segments are located again under the exclusive lock only if another insertion has split
+	/// some of their trapezoids, which is likely only for long segments or while the map is small.
+	template<class Scalar>
+	class ConcurrentTrapezoidalMap final
+	{
+
+		using PointS = Point<Scalar>;
+		using SegmentS = Segment<Scalar>;
+		using Map = TrapezoidalMap<Scalar>;
+
+		Map m_map;
+
+		/// Shared by the validations and the readers, exclusive while adding.
+		mutable Utils::SharedMutex m_mutex;
+
+		/// Check if a segment added to the map since a validation shares some x-coordinate with a validated segment.
+		/// \param[in] segment
+		/// The validated segment.
+		/// \param[in] segmentsCount
+		/// The number of segments in the map when \p segment was validated.
+		/// \pre
+		/// The mutex must be locked.
+		/// \return
+		/// \c true if the validation may be stale, \c false otherwise.
+		bool isConflicting (const SegmentS &segment, std::size_t segmentsCount) const;
+
+	public:
+
+		/// Construct an empty map with the specified bounds.
+		/// \param[in] bottomLeft
+		/// The bottom left point of the bounding box.
+		/// \param[in] topRight
+		/// The top right point of the bounding box.
+		/// \exception std::invalid_argument
+		/// If the bounds are not valid.
+		ConcurrentTrapezoidalMap (const PointS &bottomLeft, const PointS &topRight);
+
+		ConcurrentTrapezoidalMap (const ConcurrentTrapezoidalMap &) = delete;
+		ConcurrentTrapezoidalMap &operator=(const ConcurrentTrapezoidalMap &) = delete;
+
+		/// Call a function on the map while no segment is being added.
+		/// \tparam Function
+		/// Any callable type accepting a <tt>const TrapezoidalMap<Scalar> &</tt>.
+		/// \param[in] function
+		/// The function to call.
+		/// \return
+		/// The value returned by \p function.
+		/// \remark
+		/// The references to the map content obtained by \p function are valid only until it returns.
+		/// \remark
+		/// \p function must not add segments to this map.
+		template<class Function>
+		typename std::result_of<Function (const Map &)>::type read (Function &&function) const;
+
+		/// Add a segment if valid.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment has been added, the rejection reason otherwise.
+		/// \see TrapezoidalMap::tryAddSegment()
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult tryAddSegment (const SegmentS &segment);
+
+		/// Add a sequence of segments, validating all of them under a single shared lock and adding the valid ones under a single exclusive lock.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Iterator
+		/// Any forward iterator type whose value type is a Segment.
+		/// \param[in] first
+		/// The \c begin iterator of the segments to add.
+		/// \param[in] last
+		/// The \c end iterator of the segments to add.
+		/// \return
+		/// The outcome of each segment, in order.
+		/// \remark
+		/// Larger batches amortize the locking, but hold the exclusive lock longer.
+		template<class ArithmeticScalar = Scalar, class Iterator>
+		std::vector<EAddSegmentResult> tryAddSegments (Iterator first, Iterator last);
+
+		/// Add a segment.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \exception std::invalid_argument
+		/// If \p segment cannot be added.
+		/// \see TrapezoidalMap::addSegment()
+		template<class ArithmeticScalar = Scalar>
+		void addSegment (const SegmentS &segment);
+
+	};
+
+}
+
+#include "concurrent_trapezoidal_map.tpp"
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef GAS_DATA_CONCURRENT_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+#define GAS_DATA_CONCURRENT_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+
+#ifndef GAS_DATA_CONCURRENT_TRAPEZOIDAL_MAP_INCLUDED
+#error 'gas/data/concurrent_trapezoidal_map.tpp' should not be directly included
+#endif
+
+#include "concurrent_trapezoidal_map.hpp"
+
+#include <gas/utils/geometry.hpp>
+#include <mutex>
+#include <stdexcept>
+
+namespace GAS
+{
+
+	template<class Scalar>
+	bool ConcurrentTrapezoidalMap<Scalar>::isConflicting (const SegmentS &_segment, std::size_t _segmentsCount) const
+	{
+		const SegmentS segment { Geometry::sortSegmentPointsHorizontally (_segment) };
+		const Utils::ChunkedStorage<SegmentS> &segments { m_map.segments () };
+		for (std::size_t i { _segmentsCount }; i < segments.size (); i++)
+		{
+			// Stored segments are already sorted
+			if (segments[i].p1 ().x () <= segment.p2 ().x () && segment.p1 ().x () <= segments[i].p2 ().x ())
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	template<class Scalar>
+	ConcurrentTrapezoidalMap<Scalar>::ConcurrentTrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight)
+		: m_map { _bottomLeft, _topRight }
+	{}
+
+	template<class Scalar>
+	template<class Function>
+	typename std::result_of<Function (const TrapezoidalMap<Scalar> &)>::type ConcurrentTrapezoidalMap<Scalar>::read (Function &&_function) const
+	{
+		const Utils::SharedLock lock { m_mutex };
+		return _function (m_map);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult ConcurrentTrapezoidalMap<Scalar>::tryAddSegment (const SegmentS &_segment)
+	{
+		return tryAddSegments<ArithmeticScalar> (&_segment, &_segment + 1).front ();
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator>
+	std::vector<EAddSegmentResult> ConcurrentTrapezoidalMap<Scalar>::tryAddSegments (Iterator _first, Iterator _last)
+	{
+		GAS_UTILS_TRACE_SPAN ("ConcurrentTrapezoidalMap::tryAddSegments");
+		std::vector<EAddSegmentResult> results;
+		std::vector<typename Map::PreparedSegment> prepared;
+		std::size_t segmentsCount;
+		bool anyValid { false };
+		{
+			const Utils::SharedLock lock { m_mutex };
+			segmentsCount = m_map.segments ().size ();
+			for (Iterator it { _first }; it != _last; ++it)
+			{
+				prepared.emplace_back ();
+				results.push_back (m_map.template checkSegment<ArithmeticScalar> (*it, prepared.back ()));
+				anyValid |= results.back () == EAddSegmentResult::Added;
+			}
+		}
+		if (!anyValid)
+		{
+			return results;
+		}
+		std::lock_guard<Utils::SharedMutex> lock { m_mutex };
+		std::vector<EAddSegmentResult>::iterator result { results.begin () };
+		typename std::vector<typename Map::PreparedSegment>::const_iterator preparedSegment { prepared.begin () };
+		for (Iterator it { _first }; it != _last; ++it, ++result, ++preparedSegment)
+		{
+			if (*result != EAddSegmentResult::Added)
+			{
+				continue;
+			}
+			// The segments of the same batch have been validated independently, so they can conflict with each other too
+			if (isConflicting (*it, segmentsCount))
+			{
+				*result = m_map.template tryAddSegment<ArithmeticScalar> (*it);
+			}
+			else
+			{
+				m_map.template addPreparedSegment<ArithmeticScalar> (*preparedSegment);
+			}
+		}
+		return results;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	void ConcurrentTrapezoidalMap<Scalar>::addSegment (const SegmentS &_segment)
+	{
+		const EAddSegmentResult result { tryAddSegment<ArithmeticScalar> (_segment) };
+		if (result != EAddSegmentResult::Added)
+		{
+			throw std::invalid_argument (getAddSegmentResultMessage (result));
+		}
+	}
+
+}
+
+#endif
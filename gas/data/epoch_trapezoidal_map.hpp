@@ -0,0 +1,156 @@
+/// GAS::EpochTrapezoidalMap lock-free reader wrapper of GAS::TrapezoidalMap.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_DATA_EPOCH_TRAPEZOIDAL_MAP_INCLUDED
+#define GAS_DATA_EPOCH_TRAPEZOIDAL_MAP_INCLUDED
+
+#include <gas/data/mirrored_trapezoidal_map.hpp>
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <gas/utils/epoch.hpp>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace GAS
+{
+
+	/// Trapezoidal map with a single writer and many lock-free readers.
+	/// Two identical TrapezoidalMap instances are kept: the writer updates the unpublished one, publishes it with a single atomic store,
+	/// waits for the readers of the previous one to leave through Utils::EpochDomain and then replays the same segments on it.
+	/// \tparam Scalar
+	/// The scalar type.
+	/// \remark
+	/// Unlike SnapshotTrapezoidalMap, readers do not share any reference count, so they scale with the number of threads,
+	/// but they should not stay inside a Reader for long, since the writer waits for them.
+	/// \remark
+	/// If a write throws, nothing has been published and the map is left unchanged (see MirroredTrapezoidalMap).
+	/// \pre
+	/// Only one thread at a time can call the non-const methods.
+	template<class Scalar>
+	class EpochTrapezoidalMap final
+	{
+
+		using PointS = Point<Scalar>;
+		using SegmentS = Segment<Scalar>;
+		using Map = TrapezoidalMap<Scalar>;
+
+		mutable Utils::EpochDomain m_domain;
+
+		/// The two map instances.
+		MirroredTrapezoidalMap<Scalar> m_maps;
+
+		/// The published instance.
+		std::atomic<const Map *> m_published;
+
+		/// Publish an instance and wait until no reader can access the other one.
+		/// \param[in] instance
+		/// The index of the instance to publish.
+		void publish (int instance);
+
+		/// Callable that lets #m_maps publish an instance through publish().
+		class Publish final
+		{
+
+			EpochTrapezoidalMap *m_owner;
+
+		public:
+
+			explicit Publish (EpochTrapezoidalMap &owner);
+
+			void operator() (int instance) const;
+
+		};
+
+	public:
+
+		/// Read-side access to the published map.
+		/// The map will not change, and each trapezoid obtained from it stays valid, until the reader is destroyed.
+		class Reader final
+		{
+
+			Utils::EpochDomain::Guard m_guard;
+			const Map &m_map;
+
+		public:
+
+			/// Start reading.
+			/// \param[in] map
+			/// The map to read.
+			explicit Reader (const EpochTrapezoidalMap &map);
+
+			Reader (const Reader &) = delete;
+			Reader &operator=(const Reader &) = delete;
+
+			/// \return
+			/// The published map.
+			const Map &map () const;
+
+			/// \copydoc map
+			const Map &operator*() const;
+
+			/// \copydoc map
+			const Map *operator->() const;
+
+		};
+
+		/// Construct an empty map with the specified bounds.
+		/// \param[in] bottomLeft
+		/// The bottom left point of the bounding box.
+		/// \param[in] topRight
+		/// The top right point of the bounding box.
+		/// \param[in] maxReaders
+		/// The maximum number of concurrent readers that can start reading without waiting.
+		/// \exception std::invalid_argument
+		/// If the bounds are not valid or \p maxReaders is zero.
+		EpochTrapezoidalMap (const PointS &bottomLeft, const PointS &topRight, std::size_t maxReaders = 64);
+
+		EpochTrapezoidalMap (const EpochTrapezoidalMap &) = delete;
+		EpochTrapezoidalMap &operator=(const EpochTrapezoidalMap &) = delete;
+
+		/// Add a segment to both the instances, publishing the updated one.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment has been added, the rejection reason otherwise.
+		/// \see TrapezoidalMap::tryAddSegment()
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult tryAddSegment (const SegmentS &segment);
+
+		/// Add a sequence of segments to both the instances, publishing the updated one only once.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Iterator
+		/// Any forward iterator type whose value type is a Segment.
+		/// \param[in] first
+		/// The \c begin iterator of the segments to add.
+		/// \param[in] last
+		/// The \c end iterator of the segments to add.
+		/// \return
+		/// The outcome of each segment, in order.
+		/// \see TrapezoidalMap::tryAddSegments()
+		template<class ArithmeticScalar = Scalar, class Iterator>
+		std::vector<EAddSegmentResult> tryAddSegments (Iterator first, Iterator last);
+
+		/// Add a segment to both the instances, publishing the updated one.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \exception std::invalid_argument
+		/// If \p segment cannot be added.
+		/// \see TrapezoidalMap::addSegment()
+		template<class ArithmeticScalar = Scalar>
+		void addSegment (const SegmentS &segment);
+
+	};
+
+}
+
+#include "epoch_trapezoidal_map.tpp"
+
+#endif
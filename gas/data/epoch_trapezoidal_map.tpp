@@ -0,0 +1,86 @@
+#ifndef GAS_DATA_EPOCH_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+#define GAS_DATA_EPOCH_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+
+#ifndef GAS_DATA_EPOCH_TRAPEZOIDAL_MAP_INCLUDED
+#error 'gas/data/epoch_trapezoidal_map.tpp' should not be directly included
+#endif
+
+#include "epoch_trapezoidal_map.hpp"
+
+#include <stdexcept>
+
+namespace GAS
+{
+
+	template<class Scalar>
+	EpochTrapezoidalMap<Scalar>::Reader::Reader (const EpochTrapezoidalMap &_map)
+		: m_guard { _map.m_domain }, m_map { *_map.m_published.load (std::memory_order_seq_cst) }
+	{}
+
+	template<class Scalar>
+	const TrapezoidalMap<Scalar> &EpochTrapezoidalMap<Scalar>::Reader::map () const
+	{
+		return m_map;
+	}
+
+	template<class Scalar>
+	const TrapezoidalMap<Scalar> &EpochTrapezoidalMap<Scalar>::Reader::operator*() const
+	{
+		return m_map;
+	}
+
+	template<class Scalar>
+	const TrapezoidalMap<Scalar> *EpochTrapezoidalMap<Scalar>::Reader::operator->() const
+	{
+		return &m_map;
+	}
+
+	template<class Scalar>
+	EpochTrapezoidalMap<Scalar>::Publish::Publish (EpochTrapezoidalMap &_owner) : m_owner { &_owner }
+	{}
+
+	template<class Scalar>
+	void EpochTrapezoidalMap<Scalar>::Publish::operator() (int _instance) const
+	{
+		m_owner->publish (_instance);
+	}
+
+	template<class Scalar>
+	void EpochTrapezoidalMap<Scalar>::publish (int _instance)
+	{
+		GAS_UTILS_TRACE_SPAN ("EpochTrapezoidalMap::publish");
+		m_published.store (&m_maps.instance (_instance), std::memory_order_seq_cst);
+		m_domain.synchronize ();
+	}
+
+	template<class Scalar>
+	EpochTrapezoidalMap<Scalar>::EpochTrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight, std::size_t _maxReaders)
+		: m_domain { _maxReaders }, m_maps { _bottomLeft, _topRight }, m_published { &m_maps.instance (0) }
+	{}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult EpochTrapezoidalMap<Scalar>::tryAddSegment (const SegmentS &_segment)
+	{
+		GAS_UTILS_TRACE_SPAN ("EpochTrapezoidalMap::tryAddSegment");
+		return m_maps.template tryAddSegment<ArithmeticScalar> (_segment, Publish { *this });
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator>
+	std::vector<EAddSegmentResult> EpochTrapezoidalMap<Scalar>::tryAddSegments (Iterator _first, Iterator _last)
+	{
+		GAS_UTILS_TRACE_SPAN ("EpochTrapezoidalMap::tryAddSegments");
+		return m_maps.template tryAddSegments<ArithmeticScalar> (_first, _last, Publish { *this });
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	void EpochTrapezoidalMap<Scalar>::addSegment (const SegmentS &_segment)
+	{
+		m_maps.template addSegment<ArithmeticScalar> (_segment, Publish { *this });
+	}
+
+}
+
+#endif
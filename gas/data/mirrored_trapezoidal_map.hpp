@@ -0,0 +1,168 @@
+/// GAS::MirroredTrapezoidalMap pair of identical GAS::TrapezoidalMap instances, shared by the concurrent wrappers.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_DATA_MIRRORED_TRAPEZOIDAL_MAP_INCLUDED
+#define GAS_DATA_MIRRORED_TRAPEZOIDAL_MAP_INCLUDED
+
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <memory>
+#include <vector>
+
+namespace GAS
+{
+
+	/// Two identical TrapezoidalMap instances, one published to the readers and one in standby, updated by a single writer.
+	/// Each write is applied to the standby instance, which is then published through a callable provided by the wrapper,
+	/// and replayed on the previously published instance, which becomes the standby one.
+	/// The publishing callable is invoked with the index of the instance to publish (see instance()),
+	/// and must return only once no reader can access the other instance anymore, or throw without publishing anything.
+	/// Instance 0 is assumed to be published at construction.
+	/// \tparam Scalar
+	/// The scalar type.
+	/// \remark
+	/// Writes are exception-safe: if a write throws, nothing has been published and both the instances hold the same segments as before.
+	/// If the standby instance may have diverged, it is rebuilt by cloning the published one.
+	/// If the replay throws after publishing, the write still succeeds, since the readers already see its segments, and the standby instance is rebuilt instead.
+	/// When a rebuild fails too, it is retried before the next write, which throws without modifying anything as long as the rebuild keeps failing.
+	/// \remark
+	/// Not thread-safe: the wrapper must serialize the writers.
+	/// \see SnapshotTrapezoidalMap
+	/// \see EpochTrapezoidalMap
+	template<class Scalar>
+	class MirroredTrapezoidalMap final
+	{
+
+		using PointS = Point<Scalar>;
+		using SegmentS = Segment<Scalar>;
+		using Map = TrapezoidalMap<Scalar>;
+
+		/// The two map instances.
+		std::unique_ptr<Map> m_maps[2];
+
+		/// Index of the instance that is not published.
+		int m_standby { 1 };
+
+		/// Whether the standby instance may differ from the published one, and must be rebuilt before being written.
+		bool m_standbyStale {};
+
+		/// Rebuild the standby instance by cloning the published one, if stale.
+		/// \exception std::bad_alloc
+		/// If the standby instance cannot be cloned. It stays stale.
+		void refreshStandby ();
+
+		/// Mark the standby instance as stale and try to rebuild it, leaving it stale if the rebuild fails.
+		void repairStandby () noexcept;
+
+		/// Apply a write to the standby instance and, if it has been modified, publish it and replay the write on the previously published instance.
+		/// \tparam Write
+		/// The callable type, invocable with a <tt>Map &</tt> and returning whether the instance has been modified.
+		/// \tparam Replay
+		/// The callable type, invocable with a <tt>Map &</tt>.
+		/// \tparam Publish
+		/// The publishing callable type.
+		/// \param[in] write
+		/// The write to apply to the standby instance.
+		/// \param[in] replay
+		/// The same modifications made by \p write, to apply to the previously published instance.
+		/// \param[in] publish
+		/// The publishing callable.
+		template<class Write, class Replay, class Publish>
+		void write (Write write, Replay replay, Publish publish);
+
+	public:
+
+		/// Construct two empty maps with the specified bounds.
+		/// \param[in] bottomLeft
+		/// The bottom left point of the bounding box.
+		/// \param[in] topRight
+		/// The top right point of the bounding box.
+		/// \exception std::invalid_argument
+		/// If the bounds are not valid.
+		MirroredTrapezoidalMap (const PointS &bottomLeft, const PointS &topRight);
+
+		MirroredTrapezoidalMap (const MirroredTrapezoidalMap &) = delete;
+		MirroredTrapezoidalMap &operator=(const MirroredTrapezoidalMap &) = delete;
+
+		/// \param[in] index
+		/// The instance index, either 0 or 1.
+		/// \return
+		/// The instance.
+		const Map &instance (int index) const;
+
+		/// Add a segment to both the instances, publishing the updated one.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Publish
+		/// The publishing callable type.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \param[in] publish
+		/// The publishing callable, called only if \p segment is added.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment has been added, the rejection reason otherwise.
+		/// \see TrapezoidalMap::tryAddSegment()
+		template<class ArithmeticScalar, class Publish>
+		EAddSegmentResult tryAddSegment (const SegmentS &segment, Publish publish);
+
+		/// Add a sequence of segments to both the instances, publishing the updated one only once.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Iterator
+		/// Any forward iterator type whose value type is a Segment.
+		/// \tparam Publish
+		/// The publishing callable type.
+		/// \param[in] first
+		/// The \c begin iterator of the segments to add.
+		/// \param[in] last
+		/// The \c end iterator of the segments to add.
+		/// \param[in] publish
+		/// The publishing callable, called only if some segment is added.
+		/// \return
+		/// The outcome of each segment, in order.
+		/// \see TrapezoidalMap::tryAddSegments()
+		template<class ArithmeticScalar, class Iterator, class Publish>
+		std::vector<EAddSegmentResult> tryAddSegments (Iterator first, Iterator last, Publish publish);
+
+		/// Add a segment to both the instances, publishing the updated one.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Publish
+		/// The publishing callable type.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \param[in] publish
+		/// The publishing callable, called only if \p segment is added.
+		/// \exception std::invalid_argument
+		/// If \p segment cannot be added.
+		/// \see TrapezoidalMap::addSegment()
+		template<class ArithmeticScalar, class Publish>
+		void addSegment (const SegmentS &segment, Publish publish);
+
+		/// Replace both the instances, publishing the first one.
+		/// \tparam Publish
+		/// The publishing callable type.
+		/// \param[in] published
+		/// The instance to publish.
+		/// \param[in] standby
+		/// The other instance.
+		/// \param[in] publish
+		/// The publishing callable.
+		/// \pre
+		/// \p published and \p standby must be identical, that is built by adding the same segments in the same order.
+		/// \exception std::invalid_argument
+		/// If an instance is null or its bounds differ from the current ones.
+		/// \remark
+		/// If an exception is thrown, the current instances are kept.
+		template<class Publish>
+		void replace (std::unique_ptr<Map> published, std::unique_ptr<Map> standby, Publish publish);
+
+	};
+
+}
+
+#include "mirrored_trapezoidal_map.tpp"
+
+#endif
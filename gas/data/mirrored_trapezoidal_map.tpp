@@ -0,0 +1,182 @@
+#ifndef GAS_DATA_MIRRORED_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+#define GAS_DATA_MIRRORED_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+
+#ifndef GAS_DATA_MIRRORED_TRAPEZOIDAL_MAP_INCLUDED
+#error 'gas/data/mirrored_trapezoidal_map.tpp' should not be directly included
+#endif
+
+#include "mirrored_trapezoidal_map.hpp"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace GAS
+{
+
+	template<class Scalar>
+	void MirroredTrapezoidalMap<Scalar>::refreshStandby ()
+	{
+		if (m_standbyStale)
+		{
+			GAS_UTILS_TRACE_SPAN ("MirroredTrapezoidalMap::refreshStandby");
+			// Cloning only reads the published instance, so the readers can keep using it
+			*m_maps[m_standby] = *m_maps[1 - m_standby];
+			m_standbyStale = false;
+		}
+	}
+
+	template<class Scalar>
+	void MirroredTrapezoidalMap<Scalar>::repairStandby () noexcept
+	{
+		m_standbyStale = true;
+		try
+		{
+			refreshStandby ();
+		}
+		catch (...)
+		{
+			// Retried by the next write
+		}
+	}
+
+	template<class Scalar>
+	template<class Write, class Replay, class Publish>
+	void MirroredTrapezoidalMap<Scalar>::write (Write _write, Replay _replay, Publish _publish)
+	{
+		refreshStandby ();
+		bool modified {};
+		try
+		{
+			modified = _write (*m_maps[m_standby]);
+		}
+		catch (...)
+		{
+			// Part of the write may have been applied
+			repairStandby ();
+			throw;
+		}
+		if (!modified)
+		{
+			return;
+		}
+		try
+		{
+			_publish (m_standby);
+		}
+		catch (...)
+		{
+			repairStandby ();
+			throw;
+		}
+		m_standby = 1 - m_standby;
+		try
+		{
+			_replay (*m_maps[m_standby]);
+		}
+		catch (...)
+		{
+			// The write has been published, so it must not be reported as failed
+			repairStandby ();
+		}
+	}
+
+	template<class Scalar>
+	MirroredTrapezoidalMap<Scalar>::MirroredTrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight)
+		: m_maps { std::unique_ptr<Map> { new Map { _bottomLeft, _topRight } }, std::unique_ptr<Map> { new Map { _bottomLeft, _topRight } } }
+	{}
+
+	template<class Scalar>
+	const TrapezoidalMap<Scalar> &MirroredTrapezoidalMap<Scalar>::instance (int _index) const
+	{
+		assert (_index == 0 || _index == 1);
+		return *m_maps[_index];
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Publish>
+	EAddSegmentResult MirroredTrapezoidalMap<Scalar>::tryAddSegment (const SegmentS &_segment, Publish _publish)
+	{
+		EAddSegmentResult result {};
+		write ([&_segment, &result] (Map &_map) {
+			result = _map.template tryAddSegment<ArithmeticScalar> (_segment);
+			return result == EAddSegmentResult::Added;
+		}, [&_segment] (Map &_map) {
+			// The instances are identical, so the segment is known to be valid for the other one too
+			_map.template addSegmentUnchecked<ArithmeticScalar> (_segment);
+		}, _publish);
+		return result;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator, class Publish>
+	std::vector<EAddSegmentResult> MirroredTrapezoidalMap<Scalar>::tryAddSegments (Iterator _first, Iterator _last, Publish _publish)
+	{
+		std::vector<EAddSegmentResult> results;
+		write ([_first, _last, &results] (Map &_map) {
+			results = _map.template tryAddSegments<ArithmeticScalar> (_first, _last);
+			bool anyAdded { false };
+			for (const EAddSegmentResult result : results)
+			{
+				anyAdded |= result == EAddSegmentResult::Added;
+			}
+			return anyAdded;
+		}, [_first, _last, &results] (Map &_map) {
+			std::vector<EAddSegmentResult>::const_iterator result { results.begin () };
+			for (Iterator it { _first }; it != _last; ++it, ++result)
+			{
+				if (*result == EAddSegmentResult::Added)
+				{
+					_map.template addSegmentUnchecked<ArithmeticScalar> (*it);
+				}
+			}
+		}, _publish);
+		return results;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Publish>
+	void MirroredTrapezoidalMap<Scalar>::addSegment (const SegmentS &_segment, Publish _publish)
+	{
+		const EAddSegmentResult result { tryAddSegment<ArithmeticScalar> (_segment, _publish) };
+		if (result != EAddSegmentResult::Added)
+		{
+			throw std::invalid_argument (getAddSegmentResultMessage (result));
+		}
+	}
+
+	template<class Scalar>
+	template<class Publish>
+	void MirroredTrapezoidalMap<Scalar>::replace (std::unique_ptr<Map> _published, std::unique_ptr<Map> _standby, Publish _publish)
+	{
+		if (!_published || !_standby)
+		{
+			throw std::invalid_argument ("Map cannot be null");
+		}
+		const Map &current { *m_maps[1 - m_standby] };
+		for (const Map *map : { _published.get (), _standby.get () })
+		{
+			if (map->bottomLeft () != current.bottomLeft () || map->topRight () != current.topRight ())
+			{
+				throw std::invalid_argument ("Map bounds differ");
+			}
+		}
+		// The standby instance is not accessible by the readers, but it is kept until the new one is published
+		std::unique_ptr<Map> previousStandby { std::move (m_maps[m_standby]) };
+		m_maps[m_standby] = std::move (_published);
+		try
+		{
+			_publish (m_standby);
+		}
+		catch (...)
+		{
+			m_maps[m_standby] = std::move (previousStandby);
+			throw;
+		}
+		m_standby = 1 - m_standby;
+		m_maps[m_standby] = std::move (_standby);
+		m_standbyStale = false;
+	}
+
+}
+
+#endif
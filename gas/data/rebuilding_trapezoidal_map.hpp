@@ -0,0 +1,188 @@
+/// GAS::RebuildingTrapezoidalMap self-rebalancing wrapper of GAS::SnapshotTrapezoidalMap.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_DATA_REBUILDING_TRAPEZOIDAL_MAP_INCLUDED
+#define GAS_DATA_REBUILDING_TRAPEZOIDAL_MAP_INCLUDED
+
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <gas/data/snapshot_trapezoidal_map.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GAS
+{
+
+	/// Trapezoidal map that periodically rebuilds its search structure in background, adding the segments in random order.
+	/// Incremental insertions in unfavorable orders (e.g. sorted by x) can make the search structure arbitrarily deep,
+	/// while a randomized construction has logarithmic expected depth.
+	/// Queries keep being served from the current map during the rebuild, then the rebuilt map is published atomically,
+	/// after replaying the segments added in the meantime.
+	/// \tparam Scalar
+	/// The scalar type.
+	/// \remark
+	/// All the methods can be called concurrently. As for SnapshotTrapezoidalMap, a thread holding a snapshot must not call the methods that
+	/// wait for the readers, which are documented as such. The other methods never wait for the readers.
+	template<class Scalar>
+	class RebuildingTrapezoidalMap final
+	{
+
+		using PointS = Point<Scalar>;
+		using SegmentS = Segment<Scalar>;
+		using Map = TrapezoidalMap<Scalar>;
+
+	public:
+
+		/// \see SnapshotTrapezoidalMap::Snapshot
+		using Snapshot = typename SnapshotTrapezoidalMap<Scalar>::Snapshot;
+
+	private:
+
+		SnapshotTrapezoidalMap<Scalar> m_map;
+
+		/// Serializes the modifications of #m_map and of #m_segments.
+		/// \remark
+		/// Held while waiting for the readers, so it must never be locked by the methods that a thread holding a snapshot can call.
+		std::mutex m_writeMutex;
+
+		/// Guards the other members, and #m_segments along with #m_writeMutex.
+		/// \remark
+		/// Never held while waiting for the readers.
+		mutable std::mutex m_mutex;
+
+		/// All the added segments, in order.
+		/// Modified while holding both the mutexes, so it can be read while holding either.
+		std::vector<SegmentS> m_segments;
+
+		/// Number of segments in the map when the last rebuild started.
+		std::size_t m_rebuiltSegmentsCount {};
+
+		/// Minimum number of segments added since the last rebuild that triggers an automatic rebuild.
+		std::size_t m_minRebuildSize;
+
+		/// Seed of the next rebuild.
+		unsigned int m_seed;
+
+		/// Rebuild thread, joinable until collected even if finished.
+		std::thread m_thread;
+
+		/// Whether the rebuild thread is still working.
+		bool m_rebuilding {};
+
+		/// Signaled when the rebuild thread finishes.
+		std::condition_variable m_rebuildCondition;
+
+		/// Exception thrown by the last rebuild, if not yet rethrown.
+		std::exception_ptr m_error;
+
+		/// Build the shuffled map and publish it.
+		/// \param[in] segments
+		/// The segments to add.
+		/// \param[in] seed
+		/// The shuffle seed.
+		void rebuild (std::vector<SegmentS> segments, unsigned int seed);
+
+		/// Start a rebuild, joining the previous finished rebuild thread if needed.
+		/// \pre
+		/// #m_mutex must be locked and no rebuild must be running.
+		void startRebuild ();
+
+		/// Make room in #m_segments for more segments, so that recording them cannot fail once they have been published.
+		/// \pre
+		/// #m_writeMutex must be locked, while #m_mutex must not.
+		/// \param[in] count
+		/// The number of segments that may be added.
+		void reserveSegments (std::size_t count);
+
+		/// Record the added segments and start an automatic rebuild if needed.
+		/// A failure to start the rebuild is reported as a failed rebuild.
+		/// \pre
+		/// #m_writeMutex must be locked, while #m_mutex must not, and reserveSegments() must have been called.
+		template<class Iterator>
+		void onSegmentsAdded (Iterator first, Iterator last, const std::vector<EAddSegmentResult> &results);
+
+		/// Join a finished rebuild thread and rethrow its error, if any.
+		/// \pre
+		/// #m_mutex must be locked.
+		void collectRebuild ();
+
+	public:
+
+		/// Construct an empty map with the specified bounds.
+		/// \param[in] bottomLeft
+		/// The bottom left point of the bounding box.
+		/// \param[in] topRight
+		/// The top right point of the bounding box.
+		/// \param[in] minRebuildSize
+		/// A rebuild is started automatically when at least \p minRebuildSize segments and at least as many segments as the last rebuild
+		/// have been added since the last rebuild, so the amortized rebuild cost per segment is constant. Zero disables automatic rebuilds.
+		/// \param[in] seed
+		/// The seed of the first shuffle.
+		/// \exception std::invalid_argument
+		/// If the bounds are not valid.
+		RebuildingTrapezoidalMap (const PointS &bottomLeft, const PointS &topRight, std::size_t minRebuildSize = 1024, unsigned int seed = 0);
+
+		/// Wait for the running rebuild, if any, and destroy the map.
+		/// \remark
+		/// The calling thread must not hold a snapshot, since publishing the rebuilt map waits for it to be released.
+		~RebuildingTrapezoidalMap ();
+
+		RebuildingTrapezoidalMap (const RebuildingTrapezoidalMap &) = delete;
+		RebuildingTrapezoidalMap &operator=(const RebuildingTrapezoidalMap &) = delete;
+
+		/// \see SnapshotTrapezoidalMap::snapshot()
+		Snapshot snapshot () const;
+
+		/// \see SnapshotTrapezoidalMap::tryAddSegment()
+		/// \remark
+		/// The calling thread must not hold a snapshot, since the write waits for it to be released.
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult tryAddSegment (const SegmentS &segment);
+
+		/// \see SnapshotTrapezoidalMap::tryAddSegments()
+		/// \remark
+		/// The calling thread must not hold a snapshot, since the write waits for it to be released.
+		template<class ArithmeticScalar = Scalar, class Iterator>
+		std::vector<EAddSegmentResult> tryAddSegments (Iterator first, Iterator last);
+
+		/// \see SnapshotTrapezoidalMap::addSegment()
+		/// \remark
+		/// The calling thread must not hold a snapshot, since the write waits for it to be released.
+		template<class ArithmeticScalar = Scalar>
+		void addSegment (const SegmentS &segment);
+
+		/// Start a rebuild in background.
+		/// \return
+		/// \c true if the rebuild has been started, \c false if another rebuild is already running.
+		/// \exception std::exception
+		/// Any exception thrown by the previous rebuild.
+		/// \remark
+		/// It does not wait for the readers, so it can be called while holding a snapshot.
+		bool requestRebuild ();
+
+		/// Wait until the running rebuild, if any, is published.
+		/// \exception std::exception
+		/// Any exception thrown by the rebuild.
+		/// \remark
+		/// The calling thread must not hold a snapshot, since publishing waits for it to be released.
+		void waitRebuild ();
+
+		/// \return
+		/// \c true if a rebuild is running, \c false otherwise.
+		/// \remark
+		/// It does not wait for the readers, so it can be called while holding a snapshot.
+		bool isRebuilding () const;
+
+	};
+
+}
+
+#include "rebuilding_trapezoidal_map.tpp"
+
+#endif
@@ -0,0 +1,224 @@
+#ifndef GAS_DATA_REBUILDING_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+#define GAS_DATA_REBUILDING_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+
+#ifndef GAS_DATA_REBUILDING_TRAPEZOIDAL_MAP_INCLUDED
+#error 'gas/data/rebuilding_trapezoidal_map.tpp' should not be directly included
+#endif
+
+#include "rebuilding_trapezoidal_map.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace GAS
+{
+
+	template<class Scalar>
+	void RebuildingTrapezoidalMap<Scalar>::rebuild (std::vector<SegmentS> _segments, unsigned int _seed)
+	{
+		GAS_UTILS_TRACE_SPAN ("RebuildingTrapezoidalMap::rebuild");
+		try
+		{
+			std::shuffle (_segments.begin (), _segments.end (), std::mt19937 { _seed });
+			std::unique_ptr<Map> published, standby;
+			{
+				// Released before publishing, since replace() waits for it
+				const Snapshot current { m_map.snapshot () };
+				published.reset (new Map { current->bottomLeft (), current->topRight () });
+				standby.reset (new Map { current->bottomLeft (), current->topRight () });
+			}
+			// Validity does not depend on the insertion order, so the accepted segments can be added unchecked
+			published->addSegmentsUnchecked (_segments.begin (), _segments.end ());
+			standby->addSegmentsUnchecked (_segments.begin (), _segments.end ());
+			{
+				// No segment can be added until the rebuilt map is published, and the segments can be read since writing them requires this lock too
+				std::lock_guard<std::mutex> writeLock { m_writeMutex };
+				// Replay the segments added in the meantime
+				for (std::size_t i { _segments.size () }; i < m_segments.size (); i++)
+				{
+					published->addSegmentUnchecked (m_segments[i]);
+					standby->addSegmentUnchecked (m_segments[i]);
+				}
+				m_map.replace (std::move (published), std::move (standby));
+			}
+			std::lock_guard<std::mutex> lock { m_mutex };
+			m_rebuilding = false;
+			m_rebuildCondition.notify_all ();
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock { m_mutex };
+			m_error = std::current_exception ();
+			m_rebuilding = false;
+			m_rebuildCondition.notify_all ();
+		}
+	}
+
+	template<class Scalar>
+	void RebuildingTrapezoidalMap<Scalar>::startRebuild ()
+	{
+		if (m_thread.joinable ())
+		{
+			// Finished, since no rebuild is running
+			m_thread.join ();
+		}
+		m_rebuiltSegmentsCount = m_segments.size ();
+		m_rebuilding = true;
+		try
+		{
+			m_thread = std::thread { &RebuildingTrapezoidalMap::rebuild, this, m_segments, m_seed++ };
+		}
+		catch (...)
+		{
+			m_rebuilding = false;
+			throw;
+		}
+	}
+
+	template<class Scalar>
+	void RebuildingTrapezoidalMap<Scalar>::reserveSegments (std::size_t _count)
+	{
+		std::lock_guard<std::mutex> lock { m_mutex };
+		if (m_segments.capacity () - m_segments.size () < _count)
+		{
+			m_segments.reserve (std::max (m_segments.size () + _count, m_segments.capacity () * 2));
+		}
+	}
+
+	template<class Scalar>
+	template<class Iterator>
+	void RebuildingTrapezoidalMap<Scalar>::onSegmentsAdded (Iterator _first, Iterator _last, const std::vector<EAddSegmentResult> &_results)
+	{
+		std::lock_guard<std::mutex> lock { m_mutex };
+		std::vector<EAddSegmentResult>::const_iterator result { _results.begin () };
+		for (Iterator it { _first }; it != _last; ++it, ++result)
+		{
+			if (*result == EAddSegmentResult::Added)
+			{
+				m_segments.push_back (*it);
+			}
+		}
+		// Failed rebuilds are reported by requestRebuild() or waitRebuild() and stop the automatic ones
+		if (m_minRebuildSize && !m_rebuilding && !m_error)
+		{
+			const std::size_t added { m_segments.size () - m_rebuiltSegmentsCount };
+			if (added >= std::max (m_minRebuildSize, m_rebuiltSegmentsCount))
+			{
+				try
+				{
+					startRebuild ();
+				}
+				catch (...)
+				{
+					// The segments have been published, so the write must not fail
+					m_error = std::current_exception ();
+				}
+			}
+		}
+	}
+
+	template<class Scalar>
+	void RebuildingTrapezoidalMap<Scalar>::collectRebuild ()
+	{
+		if (!m_rebuilding && m_thread.joinable ())
+		{
+			m_thread.join ();
+		}
+		if (m_error)
+		{
+			std::exception_ptr error { m_error };
+			m_error = nullptr;
+			std::rethrow_exception (error);
+		}
+	}
+
+	template<class Scalar>
+	RebuildingTrapezoidalMap<Scalar>::RebuildingTrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight, std::size_t _minRebuildSize, unsigned int _seed)
+		: m_map { _bottomLeft, _topRight }, m_minRebuildSize { _minRebuildSize }, m_seed { _seed }
+	{}
+
+	template<class Scalar>
+	RebuildingTrapezoidalMap<Scalar>::~RebuildingTrapezoidalMap ()
+	{
+		std::unique_lock<std::mutex> lock { m_mutex };
+		m_rebuildCondition.wait (lock, [this] () { return !m_rebuilding; });
+		if (m_thread.joinable ())
+		{
+			m_thread.join ();
+		}
+	}
+
+	template<class Scalar>
+	typename RebuildingTrapezoidalMap<Scalar>::Snapshot RebuildingTrapezoidalMap<Scalar>::snapshot () const
+	{
+		return m_map.snapshot ();
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult RebuildingTrapezoidalMap<Scalar>::tryAddSegment (const SegmentS &_segment)
+	{
+		std::lock_guard<std::mutex> writeLock { m_writeMutex };
+		reserveSegments (1);
+		const std::vector<EAddSegmentResult> results { m_map.template tryAddSegment<ArithmeticScalar> (_segment) };
+		onSegmentsAdded (&_segment, &_segment + 1, results);
+		return results.front ();
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator>
+	std::vector<EAddSegmentResult> RebuildingTrapezoidalMap<Scalar>::tryAddSegments (Iterator _first, Iterator _last)
+	{
+		std::lock_guard<std::mutex> writeLock { m_writeMutex };
+		reserveSegments (static_cast<std::size_t>(std::distance (_first, _last)));
+		const std::vector<EAddSegmentResult> results { m_map.template tryAddSegments<ArithmeticScalar> (_first, _last) };
+		onSegmentsAdded (_first, _last, results);
+		return results;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	void RebuildingTrapezoidalMap<Scalar>::addSegment (const SegmentS &_segment)
+	{
+		const EAddSegmentResult result { tryAddSegment<ArithmeticScalar> (_segment) };
+		if (result != EAddSegmentResult::Added)
+		{
+			throw std::invalid_argument (getAddSegmentResultMessage (result));
+		}
+	}
+
+	template<class Scalar>
+	bool RebuildingTrapezoidalMap<Scalar>::requestRebuild ()
+	{
+		std::lock_guard<std::mutex> lock { m_mutex };
+		if (m_rebuilding)
+		{
+			return false;
+		}
+		collectRebuild ();
+		startRebuild ();
+		return true;
+	}
+
+	template<class Scalar>
+	void RebuildingTrapezoidalMap<Scalar>::waitRebuild ()
+	{
+		std::unique_lock<std::mutex> lock { m_mutex };
+		m_rebuildCondition.wait (lock, [this] () { return !m_rebuilding; });
+		collectRebuild ();
+	}
+
+	template<class Scalar>
+	bool RebuildingTrapezoidalMap<Scalar>::isRebuilding () const
+	{
+		std::lock_guard<std::mutex> lock { m_mutex };
+		return m_rebuilding;
+	}
+
+}
+
+#endif
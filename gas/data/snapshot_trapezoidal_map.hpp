@@ -0,0 +1,185 @@
+/// GAS::SnapshotTrapezoidalMap concurrent wrapper of GAS::TrapezoidalMap.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_DATA_SNAPSHOT_TRAPEZOIDAL_MAP_INCLUDED
+#define GAS_DATA_SNAPSHOT_TRAPEZOIDAL_MAP_INCLUDED
+
+#include <gas/data/mirrored_trapezoidal_map.hpp>
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GAS
+{
+
+	/// Trapezoidal map that serves immutable snapshots to concurrent readers while a writer adds segments.
+	/// Two identical TrapezoidalMap instances are kept: readers pin the published one, while the writer updates the other one,
+	/// publishes it and then replays the same segments on the previous one as soon as the last snapshot of it has been released.
+	/// \tparam Scalar
+	/// The scalar type.
+	/// \remark
+	/// Readers never wait for writers. Writers wait for the readers still holding the previous snapshot, so snapshots should be short-lived.
+	/// \remark
+	/// All the methods can be called concurrently. Writes are serialized.
+	/// A thread holding a snapshot must not write, since the write would wait for that snapshot to be released.
+	/// \remark
+	/// If a write throws, nothing has been published and the map is left unchanged (see MirroredTrapezoidalMap).
+	/// \note
+	/// Sharing the unchanged nodes between versions is not viable, since nodes have many parents and trapezoids link to their neighbors,
+	/// so each insertion would have to copy most of the structure. Keeping two instances doubles the memory instead.
+	template<class Scalar>
+	class SnapshotTrapezoidalMap final
+	{
+
+		using PointS = Point<Scalar>;
+		using SegmentS = Segment<Scalar>;
+		using Map = TrapezoidalMap<Scalar>;
+
+	public:
+
+		/// Immutable version of the map. The map is not modified as long as a snapshot refers to it.
+		using Snapshot = std::shared_ptr<const Map>;
+
+	private:
+
+		/// Snapshot deleter that marks the instance as released instead of destroying it.
+		class Release final
+		{
+
+			SnapshotTrapezoidalMap *m_owner;
+			int m_instance;
+
+		public:
+
+			Release (SnapshotTrapezoidalMap &owner, int instance);
+
+			void operator() (const Map *map) const;
+
+		};
+
+		/// The two map instances.
+		MirroredTrapezoidalMap<Scalar> m_maps;
+
+		/// Whether each instance is not referenced by any snapshot.
+		bool m_released[2] { true, true };
+
+		/// Published snapshot. Accessed only through the \c std::atomic_* overloads for \c std::shared_ptr.
+		Snapshot m_published;
+
+		/// Serializes the writers.
+		std::mutex m_writerMutex;
+
+		/// Guards #m_released.
+		std::mutex m_releaseMutex;
+
+		/// Signaled when an instance is released.
+		std::condition_variable m_releaseCondition;
+
+		/// Publish an instance and wait until the other one is released.
+		/// \pre
+		/// The writer mutex must be locked.
+		/// \param[in] instance
+		/// The index of the instance to publish.
+		/// \exception std::bad_alloc
+		/// If the snapshot cannot be allocated. Nothing is published in this case.
+		void publish (int instance);
+
+		/// Callable that lets #m_maps publish an instance through publish().
+		class Publish final
+		{
+
+			SnapshotTrapezoidalMap *m_owner;
+
+		public:
+
+			explicit Publish (SnapshotTrapezoidalMap &owner);
+
+			void operator() (int instance) const;
+
+		};
+
+	public:
+
+		/// Construct an empty map with the specified bounds.
+		/// \param[in] bottomLeft
+		/// The bottom left point of the bounding box.
+		/// \param[in] topRight
+		/// The top right point of the bounding box.
+		/// \exception std::invalid_argument
+		/// If the bounds are not valid.
+		SnapshotTrapezoidalMap (const PointS &bottomLeft, const PointS &topRight);
+
+		/// Wait until all the snapshots have been released and destroy the map.
+		~SnapshotTrapezoidalMap ();
+
+		SnapshotTrapezoidalMap (const SnapshotTrapezoidalMap &) = delete;
+		SnapshotTrapezoidalMap &operator=(const SnapshotTrapezoidalMap &) = delete;
+
+		/// \return
+		/// The current version of the map.
+		/// \remark
+		/// The returned map will not change, and each trapezoid obtained from it stays valid, until the snapshot is released.
+		Snapshot snapshot () const;
+
+		/// Add a segment to both the instances, publishing the updated one.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment has been added, the rejection reason otherwise.
+		/// \see TrapezoidalMap::tryAddSegment()
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult tryAddSegment (const SegmentS &segment);
+
+		/// Add a sequence of segments to both the instances, publishing the updated one only once.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Iterator
+		/// Any forward iterator type whose value type is a Segment.
+		/// \param[in] first
+		/// The \c begin iterator of the segments to add.
+		/// \param[in] last
+		/// The \c end iterator of the segments to add.
+		/// \return
+		/// The outcome of each segment, in order.
+		/// \see TrapezoidalMap::tryAddSegments()
+		template<class ArithmeticScalar = Scalar, class Iterator>
+		std::vector<EAddSegmentResult> tryAddSegments (Iterator first, Iterator last);
+
+		/// Add a segment to both the instances, publishing the updated one.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \exception std::invalid_argument
+		/// If \p segment cannot be added.
+		/// \see TrapezoidalMap::addSegment()
+		template<class ArithmeticScalar = Scalar>
+		void addSegment (const SegmentS &segment);
+
+		/// Replace both the instances, publishing the first one.
+		/// \param[in] published
+		/// The instance to publish.
+		/// \param[in] standby
+		/// The other instance.
+		/// \pre
+		/// \p published and \p standby must be identical, that is built by adding the same segments in the same order.
+		/// \exception std::invalid_argument
+		/// If an instance is null or its bounds differ from the current ones.
+		/// \remark
+		/// The current instances are destroyed once the readers have released them. If an exception is thrown, they are kept.
+		void replace (std::unique_ptr<Map> published, std::unique_ptr<Map> standby);
+
+	};
+
+}
+
+#include "snapshot_trapezoidal_map.tpp"
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef GAS_DATA_SNAPSHOT_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+#define GAS_DATA_SNAPSHOT_TRAPEZOIDAL_MAP_IMPL_INCLUDED
+
+#ifndef GAS_DATA_SNAPSHOT_TRAPEZOIDAL_MAP_INCLUDED
+#error 'gas/data/snapshot_trapezoidal_map.tpp' should not be directly included
+#endif
+
+#include "snapshot_trapezoidal_map.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace GAS
+{
+
+	template<class Scalar>
+	SnapshotTrapezoidalMap<Scalar>::Release::Release (SnapshotTrapezoidalMap &_owner, int _instance) : m_owner { &_owner }, m_instance { _instance }
+	{}
+
+	template<class Scalar>
+	void SnapshotTrapezoidalMap<Scalar>::Release::operator() (const Map */*_map*/) const
+	{
+		// Notify while locked, since the owner may be destroyed as soon as the waiter wakes up
+		std::lock_guard<std::mutex> lock { m_owner->m_releaseMutex };
+		m_owner->m_released[m_instance] = true;
+		m_owner->m_releaseCondition.notify_all ();
+	}
+
+	template<class Scalar>
+	SnapshotTrapezoidalMap<Scalar>::Publish::Publish (SnapshotTrapezoidalMap &_owner) : m_owner { &_owner }
+	{}
+
+	template<class Scalar>
+	void SnapshotTrapezoidalMap<Scalar>::Publish::operator() (int _instance) const
+	{
+		m_owner->publish (_instance);
+	}
+
+	template<class Scalar>
+	void SnapshotTrapezoidalMap<Scalar>::publish (int _instance)
+	{
+		GAS_UTILS_TRACE_SPAN ("SnapshotTrapezoidalMap::publish");
+		const int previous { 1 - _instance };
+		// Allocated first, so that nothing changes if the allocation fails
+		Snapshot snapshot { &m_maps.instance (_instance), Release { *this, _instance } };
+		{
+			std::lock_guard<std::mutex> lock { m_releaseMutex };
+			m_released[_instance] = false;
+		}
+		std::atomic_store (&m_published, std::move (snapshot));
+		{
+			std::unique_lock<std::mutex> lock { m_releaseMutex };
+			m_releaseCondition.wait (lock, [this, previous] () { return m_released[previous]; });
+		}
+	}
+
+	template<class Scalar>
+	SnapshotTrapezoidalMap<Scalar>::SnapshotTrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight)
+		: m_maps { _bottomLeft, _topRight }
+	{
+		m_published = Snapshot { &m_maps.instance (0), Release { *this, 0 } };
+		m_released[0] = false;
+	}
+
+	template<class Scalar>
+	SnapshotTrapezoidalMap<Scalar>::~SnapshotTrapezoidalMap ()
+	{
+		std::atomic_store (&m_published, Snapshot {});
+		std::unique_lock<std::mutex> lock { m_releaseMutex };
+		m_releaseCondition.wait (lock, [this] () { return m_released[0] && m_released[1]; });
+	}
+
+	template<class Scalar>
+	typename SnapshotTrapezoidalMap<Scalar>::Snapshot SnapshotTrapezoidalMap<Scalar>::snapshot () const
+	{
+		return std::atomic_load (&m_published);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult SnapshotTrapezoidalMap<Scalar>::tryAddSegment (const SegmentS &_segment)
+	{
+		GAS_UTILS_TRACE_SPAN ("SnapshotTrapezoidalMap::tryAddSegment");
+		std::lock_guard<std::mutex> lock { m_writerMutex };
+		return m_maps.template tryAddSegment<ArithmeticScalar> (_segment, Publish { *this });
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator>
+	std::vector<EAddSegmentResult> SnapshotTrapezoidalMap<Scalar>::tryAddSegments (Iterator _first, Iterator _last)
+	{
+		GAS_UTILS_TRACE_SPAN ("SnapshotTrapezoidalMap::tryAddSegments");
+		std::lock_guard<std::mutex> lock { m_writerMutex };
+		return m_maps.template tryAddSegments<ArithmeticScalar> (_first, _last, Publish { *this });
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	void SnapshotTrapezoidalMap<Scalar>::addSegment (const SegmentS &_segment)
+	{
+		std::lock_guard<std::mutex> lock { m_writerMutex };
+		m_maps.template addSegment<ArithmeticScalar> (_segment, Publish { *this });
+	}
+
+	template<class Scalar>
+	void SnapshotTrapezoidalMap<Scalar>::replace (std::unique_ptr<Map> _published, std::unique_ptr<Map> _standby)
+	{
+		GAS_UTILS_TRACE_SPAN ("SnapshotTrapezoidalMap::replace");
+		std::lock_guard<std::mutex> lock { m_writerMutex };
+		m_maps.replace (std::move (_published), std::move (_standby), Publish { *this });
+	}
+
+}
+
+#endif
@@ -10,7 +10,10 @@
 
 /// Enable an unique GAS::Trapezoid identifier for debugging purposes.
 /// If defined, an unique GAS::Utils::Serial member is added to each GAS::Trapezoid object.
-#define GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
+/// \warning
+/// Serials are drawn from a global counter, so each trapezoid creation writes shared state.
+/// Leave it undefined in production builds and when building maps on several threads.
+//#define GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
 
 #ifdef GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
 #include <gas/utils/serial.hpp>
@@ -175,6 +178,13 @@ namespace GAS
 		/// The width.
 		Scalar width () const;
 
+		/// \tparam OutputScalar
+		/// The scalar type to use to perform the arithmetic operations.
+		/// \return
+		/// The area.
+		template<class OutputScalar = Scalar>
+		OutputScalar area () const;
+
 		/// \tparam InputScalar
 		/// The scalar type to use to perform the arithmetic operations.
 		/// \return
@@ -142,39 +142,35 @@ namespace GAS
 	template<class OutputScalar>
 	Point<OutputScalar> Trapezoid<Scalar>::bottomLeft () const
 	{
-		const OutputScalar &x { static_cast<OutputScalar>(m_left->x ()) };
-		return { x, Geometry::evalLine (Geometry::cast<OutputScalar> (*m_bottom), x) };
+		return Geometry::getPointOnLine<OutputScalar> (*m_bottom, leftX ());
 	}
 
 	template<class Scalar>
 	template<class OutputScalar>
 	Point<OutputScalar> Trapezoid<Scalar>::bottomRight () const
 	{
-		const OutputScalar &x { static_cast<OutputScalar>(m_right->x ()) };
-		return { x, Geometry::evalLine (Geometry::cast<OutputScalar> (*m_bottom), x) };
+		return Geometry::getPointOnLine<OutputScalar> (*m_bottom, rightX ());
 	}
 
 	template<class Scalar>
 	template<class OutputScalar>
 	Point<OutputScalar> Trapezoid<Scalar>::topLeft () const
 	{
-		const OutputScalar &x { static_cast<OutputScalar>(m_left->x ()) };
-		return { x, Geometry::evalLine (Geometry::cast<OutputScalar> (*m_top), x) };
+		return Geometry::getPointOnLine<OutputScalar> (*m_top, leftX ());
 	}
 
 	template<class Scalar>
 	template<class OutputScalar>
 	Point<OutputScalar> Trapezoid<Scalar>::topRight () const
 	{
-		const OutputScalar &x { static_cast<OutputScalar>(m_right->x ()) };
-		return { x, Geometry::evalLine (Geometry::cast<OutputScalar> (*m_top), x) };
+		return Geometry::getPointOnLine<OutputScalar> (*m_top, rightX ());
 	}
 
 	template<class Scalar>
 	template<class OutputScalar>
 	Point<OutputScalar> Trapezoid<Scalar>::centroid () const
 	{
-		return (bottomLeft<OutputScalar> () + bottomRight<OutputScalar> () + topLeft<OutputScalar> () + topRight<OutputScalar> ()) / OutputScalar { 4 };
+		return Geometry::getTrapezoidCentroid<OutputScalar> (*m_left, *m_right, *m_bottom, *m_top);
 	}
 
 	template<class Scalar>
@@ -183,26 +179,30 @@ namespace GAS
 		return rightX () - leftX ();
 	}
 
+	template<class Scalar>
+	template<class OutputScalar>
+	OutputScalar Trapezoid<Scalar>::area () const
+	{
+		return Geometry::getTrapezoidArea<OutputScalar> (*m_left, *m_right, *m_bottom, *m_top);
+	}
+
 	template<class Scalar>
 	template<class InputScalar>
 	bool Trapezoid<Scalar>::contains (const Point<InputScalar> &_point) const
 	{
-		return _point.x () > static_cast<InputScalar>(leftX ())
-			&& _point.x () < static_cast<InputScalar>(rightX ())
-			&& Geometry::getPointSideWithSegment (Geometry::cast<InputScalar> (*m_top), _point) == Geometry::ESide::Right
-			&& Geometry::getPointSideWithSegment (Geometry::cast<InputScalar> (*m_bottom), _point) == Geometry::ESide::Left;
+		return Geometry::isPointInsideTrapezoid (_point, *m_left, *m_right, *m_bottom, *m_top);
 	}
 
 	template<class Scalar>
 	bool Trapezoid<Scalar>::isJointLeft () const
 	{
-		return m_bottom->p1 () == m_top->p1 () && m_bottom->p1 () == *m_left;
+		return Geometry::isTrapezoidJointLeft (*m_left, *m_bottom, *m_top);
 	}
 
 	template<class Scalar>
 	bool Trapezoid<Scalar>::isJointRight () const
 	{
-		return m_bottom->p2 () == m_top->p2 () && m_bottom->p2 () == *m_right;
+		return Geometry::isTrapezoidJointRight (*m_right, *m_bottom, *m_top);
 	}
 
 	template<class Scalar>
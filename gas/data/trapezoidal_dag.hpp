@@ -13,6 +13,7 @@
 #include <gas/utils/bivariant.hpp>
 #include <gas/utils/iterators.hpp>
 #include <gas/utils/ignore.hpp>
+#include <vector>
 
 namespace GAS
 {
@@ -158,6 +159,90 @@ namespace GAS
 		template<class Scalar, class QueryScalar = Scalar>
 		inline Trapezoid<Scalar> &query (Node<Scalar> &root, const Point<QueryScalar> &point);
 
+		/// Single split node visited by a point query.
+		/// \see explainQuery()
+		/// \tparam Scalar
+		/// The scalar type.
+		template<class Scalar>
+		struct QueryStep
+		{
+			const Node<Scalar> *node;		///< The visited split node.
+			ESplitType type;				///< The split type of #node.
+			Geometry::ESide side;			///< The side of the query point with respect to the split line.
+			EChild child;					///< The child through which the query continued.
+			int depth;						///< The number of split nodes visited before #node.
+		};
+
+		/// Search path followed by a point query.
+		/// \see explainQuery()
+		/// \tparam Scalar
+		/// The scalar type.
+		template<class Scalar>
+		struct QueryExplanation
+		{
+			std::vector<QueryStep<Scalar>> steps {};		///< The visited split nodes, from the root to the last one.
+			const Trapezoid<Scalar> *trapezoid {};			///< The trapezoid found by the query.
+			bool disambiguated {};							///< \c true if the query point lay on some split line and the disambiguator was used, \c false otherwise.
+		};
+
+		/// Find the trapezoid on which \p point lies and record the followed search path.
+		/// \tparam Scalar
+		/// The scalar type.
+		/// \tparam QueryScalar
+		/// The scalar type to use to perform the arithmetic operations.
+		/// \param[in] root
+		/// The root node of the search structure.
+		/// \param[in] point
+		/// The query point.
+		/// \remark
+		/// The search follows the same path of query(const Node<Scalar> &, const Point<Scalar> &).
+		/// \return
+		/// The search path and the found trapezoid.
+		template<class Scalar, class QueryScalar = Scalar>
+		QueryExplanation<Scalar> explainQuery (const Node<Scalar> &root, const Point<QueryScalar> &point);
+
+		/// Shape statistics of a search structure.
+		/// \see analyzeShape()
+		struct ShapeAnalysis
+		{
+			int maxDepth {};							///< Length of the longest path from the root to some leaf.
+			std::vector<int> leafDepthHistogram {};		///< Number of trapezoids for each longest path length, indexed by length.
+			double expectedQueryPathLength {};			///< Expected number of split nodes visited by a query for a point uniformly distributed over the trapezoids.
+		};
+
+		/// Analyze the shape of a search structure.
+		/// \tparam Scalar
+		/// The scalar type.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use to perform the arithmetic operations.
+		/// \param[in] root
+		/// The root node of the search structure.
+		/// \remark
+		/// Points in the same trapezoid may follow different paths, so the expected query path length is computed 
+		/// by weighting the path followed by the centroid of each trapezoid with the trapezoid area.
+		/// \remark
+		/// The cost is linear in the number of nodes plus one query per trapezoid.
+		/// \return
+		/// The shape statistics.
+		template<class Scalar, class ArithmeticScalar = double>
+		ShapeAnalysis analyzeShape (const Node<Scalar> &root);
+
+		/// Compute the average query path length over a set of sample points.
+		/// \tparam Scalar
+		/// The scalar type.
+		/// \tparam Iterator
+		/// Any input iterator type whose value type is a Point.
+		/// \param[in] root
+		/// The root node of the search structure.
+		/// \param[in] first
+		/// The \c begin iterator of the sample points.
+		/// \param[in] last
+		/// The \c end iterator of the sample points.
+		/// \return
+		/// The average number of split nodes visited by a query for the sample points, or \c 0 if there are no samples.
+		template<class Scalar, class Iterator>
+		double getAverageQueryPathLength (const Node<Scalar> &root, Iterator first, Iterator last);
+
 		/// Utility functions for the TDAG.
 		namespace Utils
 		{
@@ -203,6 +288,22 @@ namespace GAS
 			template<class Scalar, class QueryScalar, class Disambiguator>
 			inline EChild getPointQueryNextChild (const Split<Scalar> &split, const Point<QueryScalar> &point, Disambiguator disambiguator);
 
+			/// Get the number of split nodes visited by a point query.
+			/// \tparam Scalar
+			/// The scalar type.
+			/// \tparam QueryScalar
+			/// The scalar type to use to perform the arithmetic operations.
+			/// \param[in] root
+			/// The root node of the search structure.
+			/// \param[in] point
+			/// The query point.
+			/// \remark
+			/// If \p point lies on a split line, the search will continue on its right side.
+			/// \return
+			/// The number of split nodes visited while querying \p point.
+			template<class Scalar, class QueryScalar = Scalar>
+			int getQueryPathLength (const Node<Scalar> &root, const Point<QueryScalar> &point);
+
 			/// Convenience function for retrieving the Trapezoid referenced by a Graph::ConstLeafNodeIterator.
 			/// \tparam Scalar
 			/// The scalar type.
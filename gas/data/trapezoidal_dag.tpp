@@ -8,6 +8,7 @@
 #include "trapezoidal_dag.hpp"
 
 #include <cassert>
+#include <utility>
 
 namespace GAS
 {
@@ -88,6 +89,57 @@ namespace GAS
 			return query (_root, _point, Utils::disambiguateAlwaysRight);
 		}
 
+		template<class Scalar, class QueryScalar>
+		QueryExplanation<Scalar> explainQuery (const Node<Scalar> &_root, const Point<QueryScalar> &_point)
+		{
+			QueryExplanation<Scalar> explanation;
+			const Node<Scalar> &leaf { BDAG::walk (_root, [&](const NodeData<Scalar> &_data) {
+				const Split<Scalar> &split { _data.first () };
+				const Geometry::ESide side { Utils::getPointSide (split, _point) };
+				const EChild child { Utils::getPointQueryNextChild (split, _point, Utils::disambiguateAlwaysRight) };
+				explanation.disambiguated |= side == Geometry::ESide::Collinear;
+				explanation.steps.push_back ({ &Node<Scalar>::from (_data), split.type (), side, child, static_cast<int>(explanation.steps.size ()) });
+				return child;
+			}) };
+			explanation.trapezoid = &leaf.data ().second ();
+			return explanation;
+		}
+
+		template<class Scalar, class ArithmeticScalar>
+		ShapeAnalysis analyzeShape (const Node<Scalar> &_root)
+		{
+			ShapeAnalysis analysis;
+			const std::vector<std::pair<const Node<Scalar> *, int>> depths { BDAG::getLongestPathDepths (_root) };
+			analysis.leafDepthHistogram = BDAG::getLeafDepthHistogram (depths);
+			double totalArea {}, weightedPathLength {};
+			for (const std::pair<const Node<Scalar> *, int> &entry : depths)
+			{
+				const Node<Scalar> &node { *entry.first };
+				if (node.isLeaf ())
+				{
+					const Trapezoid<Scalar> &trapezoid { node.data ().second () };
+					const double area { static_cast<double>(trapezoid.template area<ArithmeticScalar> ()) };
+					totalArea += area;
+					weightedPathLength += area * Utils::getQueryPathLength (_root, trapezoid.template centroid<ArithmeticScalar> ());
+				}
+			}
+			analysis.maxDepth = static_cast<int>(analysis.leafDepthHistogram.size ()) - 1;
+			analysis.expectedQueryPathLength = totalArea > 0 ? weightedPathLength / totalArea : 0;
+			return analysis;
+		}
+
+		template<class Scalar, class Iterator>
+		double getAverageQueryPathLength (const Node<Scalar> &_root, Iterator _first, Iterator _last)
+		{
+			long long pathLength {}, samples {};
+			for (; _first != _last; ++_first)
+			{
+				pathLength += Utils::getQueryPathLength (_root, *_first);
+				samples++;
+			}
+			return samples ? static_cast<double>(pathLength) / samples : 0;
+		}
+
 		namespace Utils
 		{
 
@@ -124,6 +176,17 @@ namespace GAS
 				}
 			}
 
+			template<class Scalar, class QueryScalar>
+			int getQueryPathLength (const Node<Scalar> &_root, const Point<QueryScalar> &_point)
+			{
+				int length {};
+				BDAG::walk (_root, [&](const NodeData<Scalar> &_data) {
+					length++;
+					return getPointQueryNextChild (_data.first (), _point, disambiguateAlwaysRight);
+				});
+				return length;
+			}
+
 			template<class Scalar>
 			const Trapezoid<Scalar> &getTrapezoid (const typename Graph<Scalar>::ConstLeafNodeIterator &_iterator)
 			{
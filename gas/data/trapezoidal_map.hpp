@@ -9,14 +9,118 @@
 #include <gas/data/segment.hpp>
 #include <gas/data/trapezoid.hpp>
 #include <gas/data/trapezoidal_dag.hpp>
-#include <forward_list>
+#include <gas/utils/tracing.hpp>
+#include <gas/utils/chunked_storage.hpp>
+#include <gas/utils/memory_resource.hpp>
+#include <gas/utils/thread_pool.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// Enable the GAS::TrapezoidalMap operation counters for profiling purposes.
+/// If defined, each GAS::TrapezoidalMap object keeps a GAS::TrapezoidalMapStats record that is updated while adding segments and querying.
+/// If not defined, the counters are compiled out and have no runtime cost.
+//#define GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+
+/// Verify the segments passed to GAS::TrapezoidalMap::addSegmentUnchecked for debugging purposes.
+/// If defined, the unchecked insertion performs the same validation of GAS::TrapezoidalMap::addSegment and throws on invalid segments.
+/// If not defined, the validation is skipped and invalid segments result in undefined behavior.
+//#define GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_UNCHECKED_VERIFICATION
 
 namespace GAS
 {
 
+	/// Operation counters of a TrapezoidalMap.
+	/// \see GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+	struct TrapezoidalMapStats
+	{
+		long long createdTrapezoids {};			///< Trapezoids created by the map (including the initial one).
+		long long verticalSplits {};			///< Trapezoids split along a vertical line.
+		long long horizontalSplits {};			///< Trapezoids split along a non-vertical segment.
+		long long merges {};					///< Horizontal split halves merged with their left neighbor instead of being created.
+		long long welds {};						///< Calls to the neighbor welding procedure.
+		long long insertedSegments {};			///< Successfully inserted segments.
+		long long hintedSegments {};			///< Inserted segments located through an insertion hint instead of the search structure.
+		long long crossedTrapezoids {};			///< Trapezoids crossed by all the inserted segments.
+		long long maxCrossedTrapezoids {};		///< Maximum number of trapezoids crossed by a single inserted segment.
+		long long queries {};					///< Point queries.
+		long long visitedNodes {};				///< Search structure nodes visited by all the point queries (leaves included).
+		long long rejectedDegenerate {};		///< Segments rejected because degenerate.
+		long long rejectedVertical {};			///< Segments rejected because vertical.
+		long long rejectedOutOfBounds {};		///< Segments rejected because not completely inside bounds.
+		long long rejectedDuplicate {};			///< Segments rejected because duplicate.
+		long long rejectedOverlapping {};		///< Segments rejected because overlapping some other segment.
+		long long rejectedIntersecting {};		///< Segments rejected because intersecting some other segment.
+		long long rejectedSharedX {};			///< Segments rejected because sharing the x-coordinate (but not the y-coordinate) of an endpoint with another segment.
+		long long rejectedCapacityExceeded {};	///< Segments rejected because the fixed capacity of the map is exhausted.
+	};
+
+	/// Result of a TrapezoidalMap segment insertion.
+	enum class EAddSegmentResult
+	{
+		Added,			///< The segment has been added.
+		Degenerate,		///< The segment is degenerate.
+		Vertical,		///< The segment is vertical.
+		OutOfBounds,	///< The segment is not completely inside bounds.
+		Duplicate,		///< The segment is already in the map.
+		Overlapping,	///< The segment overlaps some other segment in the map.
+		Intersecting,	///< The segment intersects some other segment in the map.
+		SharedX,		///< The segment shares the x-coordinate (but not the y-coordinate) of one of its endpoints with another segment in the map.
+		CapacityExceeded	///< The segment is valid, but the map has a fixed capacity and it is exhausted.
+	};
+
+	/// \param[in] result
+	/// The insertion result.
+	/// \return
+	/// A human-readable description of \p result.
+	inline const char *getAddSegmentResultMessage (EAddSegmentResult result);
+
+	/// Memory used by a TrapezoidalMap, in bytes.
+	/// \remark
+	/// Allocator bookkeeping overhead is not included.
+	struct TrapezoidalMapMemoryUsage
+	{
+		std::size_t object {};			///< The TrapezoidalMap object itself.
+		std::size_t innerNodes {};		///< Search structure split nodes.
+		std::size_t leafNodes {};		///< Search structure leaf nodes (including the trapezoids they hold).
+		std::size_t segments {};		///< Segment storage.
+		std::size_t points {};			///< Shared point storage.
+		std::size_t auxiliary {};		///< Auxiliary indexes and buffers.
+
+		/// \return
+		/// The sum of all the other fields.
+		std::size_t total () const;
+	};
+
+	/// Storage preallocated by a fixed-capacity TrapezoidalMap.
+	/// \remark
+	/// A map with \c n segments has at most <tt>3n + 1</tt> trapezoids, but its search structure size depends on the insertion order:
+	/// it is expected to be linear for random orders (about 10 nodes per segment in practice), while it can be quadratic in the worst case.
+	/// \note
+	/// The members have no default initializers, so that it stays an aggregate in C++11.
+	struct TrapezoidalMapCapacity
+	{
+		int segments;		///< Maximum number of segments.
+		int nodes;			///< Maximum number of search structure nodes (leaves included).
+	};
+
 	/// Trapezoidal map data structure for efficient point location querying.
 	/// \tparam Scalar
 	/// The scalar type.
+	/// \remark
+	/// Distinct maps share no mutable state, so they can be built and used on different threads without synchronization
+	/// (unless #GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL is defined, in which case each trapezoid creation writes an atomic global counter).
+	/// A single map can be queried by many threads at once through its const methods, as long as no thread modifies it
+	/// and #GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS is not defined. Copying a map only reads it, so it is allowed as well.
+	/// \remark
+	/// All the nodes, segments and points are allocated from the Utils::MemoryResource passed to the constructor.
+	/// If an allocation fails while adding a segment, the segment is not added and the map is left unchanged.
+	/// \remark
+	/// A map constructed with a TrapezoidalMapCapacity preallocates all its nodes, segments and buffers, so that adding segments, clearing and
+	/// querying never allocate. Segments exceeding the capacity are rejected with EAddSegmentResult::CapacityExceeded.
+	/// Only tryAddSegments() and tryAddIndexedSegments() still allocate, for their results and for the shared points.
+	/// \see buildTrapezoidalMaps()
 	template<class Scalar>
 	class TrapezoidalMap final
 	{
@@ -27,6 +131,45 @@ namespace GAS
 		using Node = TDAG::Node<Scalar>;
 		using NodeData = TDAG::NodeData<Scalar>;
 		using Graph = TDAG::Graph<Scalar>;
+		using TrapezoidList = Utils::ResourceVector<Trapezoid *>;
+
+	public:
+
+		/// Handle for chained insertions of segments that start from an endpoint of the previously inserted segment, as in polylines.
+		/// Each successful insertion through tryAddSegment(const SegmentS &, InsertionHint &) updates the hint with the trapezoids adjacent to the
+		/// endpoints of the new segment, so that the next segment can be located without descending the search structure.
+		/// \remark
+		/// Any other modification of the map makes the hint stale. Stale or unrelated hints are detected and ignored.
+		/// \remark
+		/// A hint must not outlive the map it has been used with.
+		class InsertionHint final
+		{
+
+			friend class TrapezoidalMap;
+
+			const TrapezoidalMap *m_map {};
+			unsigned long long m_version {};
+			const SegmentS *m_segment {};
+			Trapezoid *m_leftBottom {}, *m_leftTop {}, *m_rightBottom {}, *m_rightTop {};
+
+		};
+
+		/// Segment validated by checkSegment(const SegmentS &, PreparedSegment &) const, holding the trapezoids it intersects,
+		/// so that addPreparedSegment() can add it later without locating it again.
+		/// \remark
+		/// A prepared segment must not outlive the map it has been prepared with.
+		class PreparedSegment final
+		{
+
+			friend class TrapezoidalMap;
+
+			const TrapezoidalMap *m_map {};
+			SegmentS m_segment;
+			TrapezoidList m_intersected;
+
+		};
+
+	private:
 
 		/// %Pair of horizontally or vertically stacked Trapezoid.
 		class Pair
@@ -113,41 +256,154 @@ namespace GAS
 		/// \p left and \p right must be vertically stacked pairs or single trapezoids.
 		static void weld (Pair left, Pair right);
 
-		/// \tparam ArithmeticScalar
-		/// The scalar type to use to perform the arithmetic operations.
-		/// \param[in] line
-		/// Any non-degenerate segment the lies on the line to evaluate.
-		/// \param[in] trapezoid
-		/// The trapezoid.
-		/// \return
-		/// The y-coordinate of the intersection between \p line and the right edge of \p trapezoid.
-		template<class ArithmeticScalar = Scalar>
-		static ArithmeticScalar evalLineOnRightEdge (const SegmentS &line, const Trapezoid &trapezoid);
+		/// Inserted segments providing stable references.
+		Utils::ChunkedStorage<SegmentS> m_segments;
 
-		/// List of inserted segments providing stable references.
-		std::forward_list<SegmentS> m_segments;
+		/// Points added through tryAddIndexedSegments(), providing stable references.
+		Utils::ChunkedStorage<PointS> m_points;
+
+		/// Modification counter used to detect stale InsertionHint objects.
+		unsigned long long m_version {};
 
 		/// Trapezoid search structure.
 		Graph m_graph;
 
+		/// Trapezoids intersected by the segment being added, from left to right.
+		/// Reused between insertions to avoid allocations.
+		TrapezoidList m_intersectedTrapezoids;
+
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+		/// Operation counters.
+		/// \remark
+		/// Updated by const methods too, so concurrent queries on the same map are not safe when enabled.
+		mutable TrapezoidalMapStats m_stats {};
+#endif
+
+		/// Increment an operation counter.
+		/// Does nothing if #GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS is not defined.
+		/// \param[in] counter
+		/// The counter to increment.
+		/// \param[in] amount
+		/// The increment.
+		void count (long long TrapezoidalMapStats:: *counter, long long amount = 1) const;
+
 		/// Bounding box segments.
 		/// \note
 		/// I could have used \c cg3::BoundingBox2 but I needed this two segments to be referenceable.
-		SegmentS m_bottom, m_top;
+		struct Bounds
+		{
+			SegmentS bottom, top;
+		};
+
+		/// Fixed capacity, meaningful only if #m_hasFixedCapacity is \c true.
+		TrapezoidalMapCapacity m_capacity {};
+
+		/// Whether the map has been constructed with a fixed capacity.
+		bool m_hasFixedCapacity {};
+
+		/// Heap allocated, so that the trapezoids keep referring to the same bounds when the map is moved or swapped.
+		/// \remark
+		/// \c nullptr only if the map has been moved and not modified since.
+		Utils::ResourceUniquePtr<Bounds> m_bounds;
+
+		/// Bounds of a moved map, which gets its storage back through restore().
+		/// \remark
+		/// Kept by value, so that moving never allocates: every map carries this copy of two segments besides #m_bounds, even if it is never moved.
+		Bounds m_movedBounds;
+
+		/// \exception std::logic_error
+		/// If the map has been moved and not modified since.
+		void checkNotMoved () const;
+
+		/// \return
+		/// The bounds of the map, whether it has been moved or not.
+		const Bounds &bounds () const;
+
+		/// Give a moved map its bounds and its first trapezoid back, as if it had been cleared.
+		/// Does nothing if the map has not been moved.
+		/// \exception std::bad_alloc
+		/// If the storage cannot be allocated. The map is left moved.
+		void restore ();
+
+		/// Maps the addresses inside the segments, the points and the bounds of a map to the same locations inside a clone of it.
+		class Relocator final
+		{
+
+			/// Contiguous storage of the source map and its counterpart in the clone.
+			struct Region
+			{
+				std::uintptr_t begin, end;
+				std::uintptr_t target;
+			};
+
+			/// Non-overlapping regions sorted by address.
+			std::vector<Region> m_regions;
+
+			/// Add a region.
+			/// \param[in] begin
+			/// The \c begin address in the source map.
+			/// \param[in] end
+			/// The \c end address in the source map.
+			/// \param[in] target
+			/// The \c begin address in the clone.
+			void add (const void *begin, const void *end, const void *target);
+
+		public:
+
+			/// \param[in] source
+			/// The cloned map.
+			/// \param[in] clone
+			/// The clone, whose segments and points must have been copied from \p source in the same order.
+			Relocator (const TrapezoidalMap &source, const TrapezoidalMap &clone);
+
+			/// \param[in] pointer
+			/// A pointer into the segments, the points or the bounds of the source map, or \c nullptr.
+			/// \return
+			/// The pointer to the same location inside the clone.
+			template<class Type>
+			const Type *operator() (const Type *pointer) const;
+
+		};
+
+		/// Clone a map, remapping all the references to its trapezoids, segments, points and bounds.
+		/// \param[in] copy
+		/// The map to clone.
+		/// \param[in] pool
+		/// The pool to relocate the nodes in parallel, or \c nullptr.
+		/// \pre
+		/// \p copy must not be this map.
+		/// \remark
+		/// If an exception is thrown, the map is left empty.
+		/// \see BDAG::Graph::clone()
+		void clone (const TrapezoidalMap &copy, Utils::ThreadPool *pool);
 
 		/// \remark
 		/// The root node changes only if destroy() or initialize() are called.
 		/// \pre
-		/// The search structure must not be empty.
+		/// The search structure must not be empty, so the map must have been restored if moved.
 		/// \return
 		/// The root node of the search structure.
 		Node &root ();
 
 		/// Clear the search structure and the segments list.
+		/// The storage is kept if the map has a fixed capacity.
 		/// \remark
 		/// All the references to nodes and trapezoids will be invalidated.
 		void destroy ();
 
+		/// Preallocate the storage needed to reach the fixed capacity.
+		/// Does nothing if the map has no fixed capacity.
+		/// \exception std::bad_alloc
+		/// If the storage cannot be allocated.
+		void reserveCapacity ();
+
+		/// Check if the segment being added fits in the fixed capacity.
+		/// \pre
+		/// #m_intersectedTrapezoids must contain the trapezoids intersected by the segment.
+		/// \return
+		/// \c true if the map has a fixed capacity and either the segments or the reserved nodes are not enough, \c false otherwise.
+		bool isCapacityExceeded () const;
+
 		/// Initialize the search structure with the first Trapezoid.
 		/// \pre
 		/// The search structure must be empty.
@@ -205,14 +461,15 @@ namespace GAS
 		/// The scalar type to use to perform the arithmetic operations.
 		/// \param[in] segment
 		/// The test segment.
+		/// \param[out] result
+		/// EAddSegmentResult::Duplicate, EAddSegmentResult::Overlapping or EAddSegmentResult::SharedX if \p segment is duplicated, overlapping or
+		/// shares the x-coordinate (but not the y-coordinate) of the left endpoint with another segment, EAddSegmentResult::Added otherwise.
 		/// \pre
 		/// The segment endpoints must be sorted on their x-coordinates.
 		/// \return
-		/// The leftmost trapezoid intersecting with \p segment.
-		/// \exception std::invalid_argument
-		/// If \p segment is duplicated, overlapping or shares the x-coordinate (but not the y-coordinate) of the left endpoint with another segment.
+		/// The leftmost trapezoid intersecting with \p segment, or \c nullptr if \p result is not EAddSegmentResult::Added.
 		template<class ArithmeticScalar = Scalar>
-		Trapezoid &findLeftmostIntersectedTrapezoid (const SegmentS &segment);
+		Trapezoid *findLeftmostIntersectedTrapezoid (const SegmentS &segment, EAddSegmentResult &result) const;
 
 		/// Split a trapezoid along a vertical line.
 		/// \param[in] trapezoid
@@ -249,39 +506,145 @@ namespace GAS
 		Pair incrementalSplitHorizontally (Trapezoid &trapezoid, const SegmentS &segment, NullablePair previous);
 
 		/// Update the trapezoidal map after a segment has been added to the list of segments.
-		/// Split the trapezoids intersected by \p segment, starting from \p leftmost.
-		/// \tparam ArithmeticScalar
-		/// The scalar type to use to perform the arithmetic operations.
+		/// Split the trapezoids intersected by \p segment, as collected by collectIntersectedTrapezoids().
 		/// \param[in] segment
 		/// The new segment in the list.
-		/// \param[in] leftmost
-		/// The leftmost intersected trapezoid by \p segment.
+		/// \param[in] left
+		/// The left endpoint of \p segment.
+		/// \param[in] right
+		/// The right endpoint of \p segment.
+		/// \return
+		/// A hint holding the trapezoids adjacent to the endpoints of \p segment, without the map and version.
 		/// \pre
 		/// The segment endpoints must be sorted on their x-coordinates.
+		/// \pre
+		/// #m_intersectedTrapezoids must contain the trapezoids intersected by \p segment.
 		/// \remark
-		/// The segment reference will be stored in the intersected trapezoids, so its address must be stable.
+		/// The segment and point references will be stored in the intersected trapezoids, so their addresses must be stable.
 		/// \remark
 		/// No checks for the segment validity will be made.
+		InsertionHint updateForNewSegment (const SegmentS &segment, const PointS &left, const PointS &right);
+
+		/// Add a segment if valid, using and updating an insertion hint.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \param[in,out] hint
+		/// The insertion hint. Updated only if \p segment is added.
+		/// \param[in] p1
+		/// A stable copy of the first endpoint of \p segment to reference from the trapezoids, or \c nullptr to reference the stored segment.
+		/// \param[in] p2
+		/// A stable copy of the second endpoint of \p segment to reference from the trapezoids, or \c nullptr to reference the stored segment.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment has been added, the rejection reason otherwise.
 		template<class ArithmeticScalar = Scalar>
-		void updateForNewSegment (const SegmentS &segment, Trapezoid &leftmost);
+		EAddSegmentResult insertSegment (const SegmentS &segment, InsertionHint &hint, const PointS *p1, const PointS *p2);
+
+		/// Store a segment and choose the stable endpoints to reference from the trapezoids.
+		/// Endpoints already in the map are reused, so that each point is referenced through a single address.
+		/// \param[in] sortedSegment
+		/// The segment to store.
+		/// \param[in,out] left
+		/// A stable copy of the left endpoint or \c nullptr. Set to the stable left endpoint to reference from the trapezoids.
+		/// \param[in,out] right
+		/// A stable copy of the right endpoint or \c nullptr. Set to the stable right endpoint to reference from the trapezoids.
+		/// \pre
+		/// The segment endpoints must be sorted on their x-coordinates.
+		/// \pre
+		/// #m_intersectedTrapezoids must contain the trapezoids intersected by \p sortedSegment.
+		/// \return
+		/// The stored segment.
+		const SegmentS &storeSegment (const SegmentS &sortedSegment, const PointS *&left, const PointS *&right);
 
-		/// Check if a segment intersects some other segment in the map.
+		/// Collect the trapezoids intersected by a segment, optionally checking if the segment intersects some other segment in the map.
+		/// No divisions are performed.
 		/// \tparam ArithmeticScalar
 		/// The scalar type to use to perform the arithmetic operations.
 		/// \param[in] segment
 		/// The segment to test.
 		/// \param[in] leftmost
 		/// The leftmost intersected trapezoid by \p segment.
+		/// \param[in] validate
+		/// Whether to check for intersections.
+		/// \param[out] intersected
+		/// The vector to fill with the intersected trapezoids, from left to right (usually #m_intersectedTrapezoids), or \c nullptr to only validate.
 		/// \pre
 		/// The segment endpoints must be sorted on their x-coordinates.
 		/// \pre
 		/// The segment must be contained inside the map bounds.
+		/// \pre
+		/// If \p validate is \c false, the segment must not intersect any other segment in the map.
 		/// \return
-		/// \c true if \p segment intersects some other segment in the map, \c false otherwise.
-		/// \exception std::invalid_argument
-		/// If \p segment shares the x-coordinate (but not the y-coordinate) of the right endpoint with another segment.
+		/// EAddSegmentResult::Intersecting if \p segment intersects some other segment in the map, EAddSegmentResult::SharedX if \p segment
+		/// shares the x-coordinate (but not the y-coordinate) of the right endpoint with another segment, EAddSegmentResult::Added otherwise.
+		/// \remark
+		/// \p intersected is complete only if EAddSegmentResult::Added is returned.
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult collectIntersectedTrapezoids (const SegmentS &segment, Trapezoid &leftmost, bool validate, TrapezoidList *intersected) const;
+
+		/// Check if a segment can be added to the map.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use to perform the arithmetic operations.
+		/// \param[in] segment
+		/// The segment to test.
+		/// \param[out] sortedSegment
+		/// The same segment with the endpoints sorted on their x-coordinates.
+		/// \param[out] leftmost
+		/// The leftmost trapezoid intersected by \p sortedSegment. Only set if the segment can be added.
+		/// \param[in] hint
+		/// The hint to use to locate \p leftmost before falling back to the search structure.
+		/// \param[out] intersected
+		/// The vector to fill with the trapezoids intersected by \p sortedSegment, or \c nullptr.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment can be added, the rejection reason otherwise.
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult validateSegment (const SegmentS &segment, SegmentS &sortedSegment, Trapezoid *&leftmost, const InsertionHint &hint, TrapezoidList *intersected) const;
+
+		/// Check if a segment enters a trapezoid from its left point.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use to perform the arithmetic operations.
+		/// \param[in] segment
+		/// The test segment.
+		/// \param[in] trapezoid
+		/// The test trapezoid.
+		/// \pre
+		/// The segment endpoints must be sorted on their x-coordinates.
+		/// \return
+		/// \c true if the left point of \p trapezoid is the left endpoint of \p segment and \p segment lies strictly between the bottom and
+		/// the top segments of \p trapezoid on its right, \c false otherwise.
+		template<class ArithmeticScalar = Scalar>
+		static bool isSegmentStartingInside (const SegmentS &segment, const Trapezoid &trapezoid);
+
+		/// Find the leftmost trapezoid intersected by a segment through an insertion hint.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use to perform the arithmetic operations.
+		/// \param[in] segment
+		/// The test segment.
+		/// \param[in] hint
+		/// The insertion hint.
+		/// \pre
+		/// The segment endpoints must be sorted on their x-coordinates.
+		/// \return
+		/// The leftmost trapezoid intersecting with \p segment, or \c nullptr if \p hint is stale or if the left endpoint of \p segment
+		/// is not an endpoint of the hinted segment.
 		template<class ArithmeticScalar = Scalar>
-		bool doesSegmentIntersect (const SegmentS &segment, const Trapezoid &leftmost) const;
+		Trapezoid *findLeftmostIntersectedTrapezoid (const SegmentS &segment, const InsertionHint &hint) const;
+
+		/// Add a segment whose intersected trapezoids have been collected into #m_intersectedTrapezoids.
+		/// \param[in] sortedSegment
+		/// The segment to add.
+		/// \pre
+		/// The segment endpoints must be sorted on their x-coordinates and the segment must be valid.
+		/// \exception std::invalid_argument
+		/// If the fixed capacity is exhausted.
+		void addCollectedSegment (const SegmentS &sortedSegment);
+
+		/// Increment the operation counter of a rejection reason.
+		/// Does nothing if #GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS is not defined or if \p result is EAddSegmentResult::Added.
+		/// \param[in] result
+		/// The rejection reason.
+		void countRejection (EAddSegmentResult result) const;
 
 	public:
 
@@ -290,38 +653,87 @@ namespace GAS
 		/// The bottom left point of the bounding box.
 		/// \param[in] topRight
 		/// The top right point of the bounding box.
+		/// \param[in] resource
+		/// The resource to allocate from. It must outlive the map.
 		/// \remark
 		/// An empty trapezoidal map still has a single trapezoid.
 		/// \exception std::invalid_argument
 		/// If the two points are inverted or equal.
-		TrapezoidalMap (const PointS &bottomLeft, const PointS &topRight);
+		TrapezoidalMap (const PointS &bottomLeft, const PointS &topRight, Utils::MemoryResource &resource = Utils::newDeleteResource ());
 
-		/// Construct a trapezoidal map by cloning \p copy.
+		/// Construct an empty trapezoidal map with a fixed capacity, preallocating all its storage.
+		/// \param[in] bottomLeft
+		/// The bottom left point of the bounding box.
+		/// \param[in] topRight
+		/// The top right point of the bounding box.
+		/// \param[in] capacity
+		/// The capacity. The initial trapezoid takes one node.
+		/// \param[in] resource
+		/// The resource to allocate from. It must outlive the map.
+		/// \exception std::invalid_argument
+		/// If the two points are inverted or equal or if \p capacity is negative or has no nodes.
+		/// \exception std::bad_alloc
+		/// If the storage cannot be allocated.
+		TrapezoidalMap (const PointS &bottomLeft, const PointS &topRight, const TrapezoidalMapCapacity &capacity, Utils::MemoryResource &resource = Utils::newDeleteResource ());
+
+		/// Construct a trapezoidal map using Utils::newDeleteResource() by cloning \p copy, including its fixed capacity if any.
+		/// It runs in linear time.
 		/// \param[in] copy
 		/// The trapezoidal map to clone.
-		TrapezoidalMap (const TrapezoidalMap &copy) = default;
+		/// \remark
+		/// \p copy is only read, so other threads can query or clone it meanwhile.
+		TrapezoidalMap (const TrapezoidalMap &copy);
+
+		/// Construct a trapezoidal map using Utils::newDeleteResource() by cloning \p copy (including its fixed capacity if any), relocating the search structure in parallel.
+		/// Worth it only for huge maps, since the nodes are still allocated by the calling thread.
+		/// \param[in] copy
+		/// The trapezoidal map to clone.
+		/// \param[in] pool
+		/// The pool running the relocation.
+		/// \remark
+		/// \p copy is only read, so other threads can query or clone it meanwhile.
+		TrapezoidalMap (const TrapezoidalMap &copy, Utils::ThreadPool &pool);
 
 		/// Construct a trapezoidal map by moving \p moved.
+		/// It runs in constant time and preserves all the references to the content of \p moved, which now belongs to this map.
 		/// \param[in] moved
 		/// The trapezoidal map to move.
 		/// \remark
-		/// After calling this constructor \p moved will be empty and valid.
-		TrapezoidalMap (TrapezoidalMap &&moved);
+		/// After calling this constructor \p moved is empty and valid, and keeps its bounds.
+		/// Since moving never allocates, \p moved gets its first trapezoid back only when it is modified (see clear(), setBounds() and the methods adding segments):
+		/// until then it has no trapezoids, and root(), query() and checkSegment() throw \c std::logic_error.
+		/// \remark
+		/// InsertionHint objects used with \p moved become stale.
+		TrapezoidalMap (TrapezoidalMap &&moved) noexcept;
 
 		/// \see clear()
 		~TrapezoidalMap () = default;
 
-		/// Clear the map and clone \p copy.
+		/// Clear the map and clone \p copy, including its fixed capacity if any, keeping the current resource.
 		/// \param[in] copy
 		/// The trapezoidal map to clone.
-		TrapezoidalMap &operator =(const TrapezoidalMap &copy) = default;
+		/// \remark
+		/// \p copy is only read, so other threads can query or clone it meanwhile.
+		/// \remark
+		/// If an exception is thrown, the map is left empty.
+		TrapezoidalMap &operator =(const TrapezoidalMap &copy);
 
 		/// Clear the map and move \p moved.
+		/// It runs in constant time, apart from destroying the current content.
 		/// \param[in] moved
 		/// The trapezoidal map to move.
 		/// \remark
-		/// After calling this assignment operator \p moved will be empty and valid.
-		TrapezoidalMap &operator =(TrapezoidalMap &&moved);
+		/// After calling this assignment operator \p moved is empty and valid, as after a move construction.
+		/// \see TrapezoidalMap(TrapezoidalMap &&)
+		TrapezoidalMap &operator =(TrapezoidalMap &&moved) noexcept;
+
+		/// Exchange the content of two maps in constant time.
+		/// All the references to the content of the maps are preserved and follow the content.
+		/// \param[in] other
+		/// The map to swap with.
+		/// \remark
+		/// InsertionHint objects used with either map become stale.
+		void swap (TrapezoidalMap &other) noexcept;
 
 		/// Get the root node of the search structure.
 		/// \see TDAG
@@ -329,6 +741,8 @@ namespace GAS
 		/// The root node changes only when the map is cleared (when the map is moved or assigned or clear() is called).
 		/// \return
 		/// The root node of the search structure.
+		/// \exception std::logic_error
+		/// If the map has been moved and not modified since, so that it has no trapezoids.
 		const Node &root () const;
 
 		/// Get the number of trapezoids in the map.
@@ -336,6 +750,32 @@ namespace GAS
 		/// The number of trapezoids.
 		int trapezoidsCount () const;
 
+		/// Get the number of segments in the map.
+		/// \return
+		/// The number of segments.
+		int segmentsCount () const;
+
+		/// Get the memory used by the map.
+		/// \remark
+		/// It runs in constant time.
+		/// \return
+		/// The memory usage breakdown.
+		TrapezoidalMapMemoryUsage memoryUsage () const;
+
+		/// \return
+		/// The resource the map allocates from.
+		Utils::MemoryResource &resource () const;
+
+		/// \return
+		/// \c true if the map has been constructed with a fixed capacity (or cloned or moved from such a map), \c false otherwise.
+		bool hasFixedCapacity () const;
+
+		/// \pre
+		/// The map must have a fixed capacity.
+		/// \return
+		/// The fixed capacity.
+		const TrapezoidalMapCapacity &capacity () const;
+
 		/// Get the \c begin iterator for iterating through all the trapezoids.
 		/// The iteration follows the order of creation of the trapezoids (note that splitting a trapezoid creates two new trapezoids).
 		/// \return
@@ -359,9 +799,35 @@ namespace GAS
 		/// The trapezoid that contains \p point.
 		/// \exception std::invalid_argument
 		/// If \p point is outside the bounding box.
+		/// \exception std::logic_error
+		/// If the map has been moved and not modified since, so that it has no trapezoids.
 		template<class QueryScalar = Scalar>
 		const Trapezoid &query (const Point<QueryScalar> &point) const;
 
+		/// Find the trapezoid in the map that contains the point \p point and record the followed search path.
+		/// \see TDAG::explainQuery()
+		/// \tparam QueryScalar
+		/// The scalar type to use when performing the arithmetic operations needed to localize the point.
+		/// \return
+		/// The search path and the trapezoid that contains \p point.
+		/// \exception std::invalid_argument
+		/// If \p point is outside the bounding box.
+		/// \exception std::logic_error
+		/// If the map has been moved and not modified since, so that it has no trapezoids.
+		template<class QueryScalar = Scalar>
+		TDAG::QueryExplanation<Scalar> explainQuery (const Point<QueryScalar> &point) const;
+
+		/// Analyze the shape of the search structure.
+		/// \see TDAG::analyzeShape()
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use to perform the arithmetic operations.
+		/// \return
+		/// The shape statistics.
+		/// \exception std::logic_error
+		/// If the map has been moved and not modified since, so that it has no trapezoids.
+		template<class ArithmeticScalar = double>
+		TDAG::ShapeAnalysis analyzeShape () const;
+
 		/// \return
 		/// The bottom left point of the bounding box.
 		const PointS &bottomLeft () const;
@@ -413,11 +879,57 @@ namespace GAS
 		/// \c true if \p point is inside bounds, \c false otherwise.
 		bool isPointInsideBounds (const PointS &point) const;
 
-		/// Get the list of all the segments in the map.
-		/// The list follows the inverse order of insertion of the segments.
+		/// Get all the segments in the map.
+		/// The segments follow the order of insertion and have their endpoints sorted on their x-coordinates.
+		/// \return
+		/// The segments.
+		const Utils::ChunkedStorage<SegmentS> &segments () const;
+
+		/// Check if a segment can be added to the map, without adding it.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations.
+		/// \param[in] segment
+		/// The segment to test.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment can be added, the rejection reason that tryAddSegment() would report otherwise.
+		/// \remark
+		/// Since segments are never removed, a rejected segment stays rejected as the map grows.
+		/// \remark
+		/// The fixed capacity is not checked, since the nodes needed are known only when adding.
+		/// \exception std::logic_error
+		/// If the map has been moved and not modified since, so that it has no trapezoids.
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult checkSegment (const SegmentS &segment) const;
+
+		/// Check if a segment can be added to the map, without adding it, and prepare its insertion.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations.
+		/// \param[in] segment
+		/// The segment to test.
+		/// \param[out] prepared
+		/// The prepared insertion, to pass to addPreparedSegment(). Meaningful only if EAddSegmentResult::Added is returned.
 		/// \return
-		/// The list of the segments.
-		const std::forward_list<SegmentS> &segments () const;
+		/// The same result of checkSegment(const SegmentS &) const.
+		/// \remark
+		/// Like the other const methods, it can run concurrently with other readers.
+		/// \exception std::logic_error
+		/// If the map has been moved and not modified since, so that it has no trapezoids.
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult checkSegment (const SegmentS &segment, PreparedSegment &prepared) const;
+
+		/// Add a segment prepared by checkSegment(const SegmentS &, PreparedSegment &) const.
+		/// The prepared trapezoids are reused if none of them has been split since, otherwise the segment is located again.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to locate the segment again.
+		/// \param[in] prepared
+		/// The prepared insertion.
+		/// \pre
+		/// \p prepared must have been accepted by this map, and the segment must still be valid, as it is if no segment sharing
+		/// some x-coordinate with it has been added since. The map must not have been cleared, moved or assigned since.
+		/// \exception std::invalid_argument
+		/// If the fixed capacity is exhausted.
+		template<class ArithmeticScalar = Scalar>
+		void addPreparedSegment (const PreparedSegment &prepared);
 
 		/// Add a segment to the list of the segments and update the map accordingly.
 		/// \tparam ArithmeticScalar
@@ -426,17 +938,144 @@ namespace GAS
 		/// The segment to add.
 		/// \exception std::invalid_argument
 		/// If \p segment is not inside the bounds, degenerate, duplicate, vertical, overlapping, intersecting or shares 
-		/// the x-coordinate (but not the y-coordinate) of one of its endpoints with another segment in the map.
+		/// the x-coordinate (but not the y-coordinate) of one of its endpoints with another segment in the map, or if the fixed capacity is exhausted.
 		template<class ArithmeticScalar = Scalar>
 		void addSegment (const SegmentS &segment);
 
+		/// Add a segment to the list of the segments and update the map accordingly, if the segment is valid.
+		/// Unlike addSegment(), invalid segments are reported without throwing.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment has been added, the rejection reason otherwise.
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult tryAddSegment (const SegmentS &segment);
+
+		/// Add a sequence of segments through tryAddSegment().
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Iterator
+		/// Any input iterator type whose value type is a Segment.
+		/// \param[in] first
+		/// The \c begin iterator of the segments to add.
+		/// \param[in] last
+		/// The \c end iterator of the segments to add.
+		/// \return
+		/// The result of each insertion, in the same order of the segments.
+		template<class ArithmeticScalar = Scalar, class Iterator>
+		std::vector<EAddSegmentResult> tryAddSegments (Iterator first, Iterator last);
+
+		/// Add a segment through tryAddSegment(), using and updating an insertion hint.
+		/// If the left endpoint of \p segment is an endpoint of the segment last inserted with \p hint, the search structure descent is skipped.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \param[in,out] hint
+		/// The insertion hint. Updated only if \p segment is added.
+		/// \return
+		/// EAddSegmentResult::Added if \p segment has been added, the rejection reason otherwise.
+		template<class ArithmeticScalar = Scalar>
+		EAddSegmentResult tryAddSegment (const SegmentS &segment, InsertionHint &hint);
+
+		/// Add the segments of a polyline.
+		/// Each segment is located starting from the trapezoids adjacent to the end of the previous one when possible.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Iterator
+		/// Any input iterator type whose value type is a Point.
+		/// \param[in] first
+		/// The \c begin iterator of the polyline vertices.
+		/// \param[in] last
+		/// The \c end iterator of the polyline vertices.
+		/// \exception std::invalid_argument
+		/// If any segment would make addSegment() throw. The segments preceding it are left in the map.
+		template<class ArithmeticScalar = Scalar, class Iterator>
+		void addPolyline (Iterator first, Iterator last);
+
+		/// Add a set of segments given as indices into a point array, as stored by an indexed dataset.
+		/// The points are copied once into a table owned by the map, and the trapezoids reference the shared copies.
+		/// Segments are added through tryAddSegment(const SegmentS &, InsertionHint &), chaining consecutive segments.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam PointIterator
+		/// Any input iterator type whose value type is a Point.
+		/// \tparam IndexIterator
+		/// Any input iterator type whose value type has \c first and \c second integral members, like \c std::pair.
+		/// \param[in] pointsFirst
+		/// The \c begin iterator of the points.
+		/// \param[in] pointsLast
+		/// The \c end iterator of the points.
+		/// \param[in] segmentsFirst
+		/// The \c begin iterator of the index pairs.
+		/// \param[in] segmentsLast
+		/// The \c end iterator of the index pairs.
+		/// \return
+		/// The result of each insertion, in the same order of the index pairs.
+		/// \exception std::invalid_argument
+		/// If any index is out of range. No segment is added in this case.
+		template<class ArithmeticScalar = Scalar, class PointIterator, class IndexIterator>
+		std::vector<EAddSegmentResult> tryAddIndexedSegments (PointIterator pointsFirst, PointIterator pointsLast, IndexIterator segmentsFirst, IndexIterator segmentsLast);
+
+		/// Add a trusted segment to the list of the segments and update the map accordingly, skipping the validation.
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \param[in] segment
+		/// The segment to add.
+		/// \pre
+		/// \p segment must be a valid segment for addSegment(). Invalid segments result in undefined behavior.
+		/// \exception std::invalid_argument
+		/// If the fixed capacity is exhausted, or if #GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_UNCHECKED_VERIFICATION is defined and addSegment() would throw.
+		template<class ArithmeticScalar = Scalar>
+		void addSegmentUnchecked (const SegmentS &segment);
+
+		/// Add a sequence of trusted segments through addSegmentUnchecked().
+		/// \tparam ArithmeticScalar
+		/// The scalar type to use when performing the arithmetic operations needed to update the map.
+		/// \tparam Iterator
+		/// Any input iterator type whose value type is a Segment.
+		/// \param[in] first
+		/// The \c begin iterator of the segments to add.
+		/// \param[in] last
+		/// The \c end iterator of the segments to add.
+		/// \pre
+		/// Each segment must be a valid segment for addSegment() once the previous ones have been added.
+		template<class ArithmeticScalar = Scalar, class Iterator>
+		void addSegmentsUnchecked (Iterator first, Iterator last);
+
 		/// Clear the map.
 		/// \remark
 		/// The root node obtained through root() const and all the trapezoids in the map will be invalidated.
+		/// \remark
+		/// A map with a fixed capacity keeps all its storage.
+		/// \remark
+		/// The operation counters are not reset.
 		void clear ();
 
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+
+		/// \return
+		/// A snapshot of the operation counters.
+		TrapezoidalMapStats stats () const;
+
+		/// Reset all the operation counters to zero.
+		void resetStats ();
+
+#endif
+
 	};
 
+	/// Exchange the content of two maps in constant time, enabling \c std::swap through argument-dependent lookup.
+	/// \param[in] a
+	/// The first map.
+	/// \param[in] b
+	/// The second map.
+	/// \see TrapezoidalMap::swap()
+	template<class Scalar>
+	void swap (TrapezoidalMap<Scalar> &a, TrapezoidalMap<Scalar> &b) noexcept;
+
 }
 
 #include "trapezoidal_map.tpp"
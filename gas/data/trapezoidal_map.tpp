@@ -10,10 +10,45 @@
 #include <stdexcept>
 #include <cassert>
 #include <utility>
+#include <algorithm>
+#include <initializer_list>
 #include <gas/utils/geometry.hpp>
 
 namespace GAS
 {
+	inline std::size_t TrapezoidalMapMemoryUsage::total () const
+	{
+		return object + innerNodes + leafNodes + segments + points + auxiliary;
+	}
+
+	inline const char *getAddSegmentResultMessage (EAddSegmentResult _result)
+	{
+		switch (_result)
+		{
+			case EAddSegmentResult::Added:
+				return "Segment added";
+			case EAddSegmentResult::Degenerate:
+				return "Segment is degenerate";
+			case EAddSegmentResult::Vertical:
+				return "Segment is vertical";
+			case EAddSegmentResult::OutOfBounds:
+				return "Segment is not completely inside bounds";
+			case EAddSegmentResult::Duplicate:
+				return "Duplicate segments are illegal";
+			case EAddSegmentResult::Overlapping:
+				return "Overlapping segments are illegal";
+			case EAddSegmentResult::Intersecting:
+				return "Segment intersects some other segment in the map";
+			case EAddSegmentResult::SharedX:
+				return "Points with the same x-coordinate are illegal";
+			case EAddSegmentResult::CapacityExceeded:
+				return "Map capacity exceeded";
+			default:
+				assert (false);
+				return "Unknown result";
+		}
+	}
+
 	template<class Scalar>
 	TrapezoidalMap<Scalar>::Pair::Pair (Trapezoid *_leftOrBottom, Trapezoid *_rightOrTop) : m_a { _leftOrBottom }, m_b { _rightOrTop }
 	{}
@@ -87,17 +122,208 @@ namespace GAS
 		return Pair::m_a;
 	}
 
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::count (long long TrapezoidalMapStats:: *_counter, long long _amount) const
+	{
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+		m_stats.*_counter += _amount;
+#else
+		(void) _counter;
+		(void) _amount;
+#endif
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::countRejection (EAddSegmentResult _result) const
+	{
+		switch (_result)
+		{
+			case EAddSegmentResult::Added:
+				break;
+			case EAddSegmentResult::Degenerate:
+				count (&TrapezoidalMapStats::rejectedDegenerate);
+				break;
+			case EAddSegmentResult::Vertical:
+				count (&TrapezoidalMapStats::rejectedVertical);
+				break;
+			case EAddSegmentResult::OutOfBounds:
+				count (&TrapezoidalMapStats::rejectedOutOfBounds);
+				break;
+			case EAddSegmentResult::Duplicate:
+				count (&TrapezoidalMapStats::rejectedDuplicate);
+				break;
+			case EAddSegmentResult::Overlapping:
+				count (&TrapezoidalMapStats::rejectedOverlapping);
+				break;
+			case EAddSegmentResult::Intersecting:
+				count (&TrapezoidalMapStats::rejectedIntersecting);
+				break;
+			case EAddSegmentResult::SharedX:
+				count (&TrapezoidalMapStats::rejectedSharedX);
+				break;
+			case EAddSegmentResult::CapacityExceeded:
+				count (&TrapezoidalMapStats::rejectedCapacityExceeded);
+				break;
+		}
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::Relocator::add (const void *_begin, const void *_end, const void *_target)
+	{
+		m_regions.push_back (Region { reinterpret_cast<std::uintptr_t>(_begin), reinterpret_cast<std::uintptr_t>(_end), reinterpret_cast<std::uintptr_t>(_target) });
+	}
+
+	template<class Scalar>
+	TrapezoidalMap<Scalar>::Relocator::Relocator (const TrapezoidalMap &_source, const TrapezoidalMap &_clone)
+	{
+		add (_source.m_bounds.get (), _source.m_bounds.get () + 1, _clone.m_bounds.get ());
+		// Copied storages have the same layout, although the source may have spare chunks
+		const std::size_t segmentChunks { std::min (_source.m_segments.chunksCount (), _clone.m_segments.chunksCount ()) };
+		for (std::size_t i {}; i < segmentChunks; i++)
+		{
+			const std::pair<const void *, const void *> range { _source.m_segments.chunkRange (i) };
+			add (range.first, range.second, _clone.m_segments.chunkRange (i).first);
+		}
+		const std::size_t pointChunks { std::min (_source.m_points.chunksCount (), _clone.m_points.chunksCount ()) };
+		for (std::size_t i {}; i < pointChunks; i++)
+		{
+			const std::pair<const void *, const void *> range { _source.m_points.chunkRange (i) };
+			add (range.first, range.second, _clone.m_points.chunkRange (i).first);
+		}
+		std::sort (m_regions.begin (), m_regions.end (), [](const Region &_a, const Region &_b) {
+			return _a.begin < _b.begin;
+		});
+	}
+
+	template<class Scalar>
+	template<class Type>
+	const Type *TrapezoidalMap<Scalar>::Relocator::operator() (const Type *_pointer) const
+	{
+		if (!_pointer)
+		{
+			return nullptr;
+		}
+		const std::uintptr_t address { reinterpret_cast<std::uintptr_t>(_pointer) };
+		// The last region starting at or before the address
+		typename std::vector<Region>::const_iterator region { std::upper_bound (m_regions.begin (), m_regions.end (), address, [](std::uintptr_t _address, const Region &_region) {
+			return _address < _region.begin;
+		}) };
+		assert (region != m_regions.begin ());
+		--region;
+		assert (address < region->end);
+		return reinterpret_cast<const Type *>(region->target + (address - region->begin));
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::clone (const TrapezoidalMap &_copy, Utils::ThreadPool *_pool)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::clone");
+		assert (this != &_copy);
+		m_capacity = _copy.m_capacity;
+		m_hasFixedCapacity = _copy.m_hasFixedCapacity;
+		if (!_copy.m_bounds)
+		{
+			// A moved map is cloned as it is, without allocating anything
+			destroy ();
+			m_bounds.reset ();
+			m_movedBounds = _copy.m_movedBounds;
+		}
+		else
+		{
+			// A moved map has no bounds to reuse
+			if (m_bounds)
+			{
+				*m_bounds = *_copy.m_bounds;
+			}
+			else
+			{
+				m_bounds = Utils::allocateUnique<Bounds> (resource (), *_copy.m_bounds);
+			}
+			try
+			{
+				destroy ();
+				m_segments = _copy.m_segments;
+				m_points = _copy.m_points;
+				const Relocator relocator { _copy, *this };
+				m_graph.clone (_copy.m_graph, [&relocator](NodeData &_data, const typename Graph::CloneMap &_clones) {
+					if (_data.isFirstType ())
+					{
+						TDAG::Split<Scalar> &split { _data.first () };
+						if (split.type () == TDAG::ESplitType::Vertical)
+						{
+							split.setVertical (*relocator (&split.x ()));
+						}
+						else
+						{
+							split.setNonVertical (*relocator (&split.segment ()));
+						}
+					}
+					else
+					{
+						Trapezoid &trapezoid { _data.second () };
+						trapezoid.left () = relocator (trapezoid.left ());
+						trapezoid.right () = relocator (trapezoid.right ());
+						trapezoid.bottom () = relocator (trapezoid.bottom ());
+						trapezoid.top () = relocator (trapezoid.top ());
+						for (Trapezoid **neighbor : { &trapezoid.lowerLeftNeighbor (), &trapezoid.upperLeftNeighbor (), &trapezoid.lowerRightNeighbor (), &trapezoid.upperRightNeighbor () })
+						{
+							if (*neighbor)
+							{
+								*neighbor = &_clones (Node::from (NodeData::from (**neighbor))).data ().second ();
+							}
+						}
+					}
+				}, _pool);
+				reserveCapacity ();
+			}
+			catch (...)
+			{
+				destroy ();
+				initialize ();
+				throw;
+			}
+		}
+		// Hints of the copy are rejected anyway, since they refer to the other map, but the old hints of this map must not become valid again
+		m_version = std::max (m_version, _copy.m_version) + 1;
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+		m_stats = _copy.m_stats;
+#endif
+	}
+
 	template<class Scalar>
 	TDAG::Node<Scalar> &TrapezoidalMap<Scalar>::root ()
 	{
+		assert (!m_graph.isEmpty ());
 		return *m_graph.nodes ().begin ();
 	}
 
 	template<class Scalar>
 	void TrapezoidalMap<Scalar>::destroy ()
 	{
-		m_graph.clear ();
-		m_segments.clear ();
+		const bool release { !m_hasFixedCapacity };
+		m_graph.clear (release);
+		m_segments.clear (release);
+		m_points.clear (release);
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::reserveCapacity ()
+	{
+		if (m_hasFixedCapacity)
+		{
+			m_graph.reserve (m_capacity.nodes - m_graph.nodesCount ());
+			m_segments.reserve (static_cast<std::size_t>(m_capacity.segments));
+			// A segment cannot cross more trapezoids than the map has
+			m_intersectedTrapezoids.reserve (static_cast<std::size_t>(m_capacity.segments) * 3 + 1);
+		}
+	}
+
+	template<class Scalar>
+	bool TrapezoidalMap<Scalar>::isCapacityExceeded () const
+	{
+		// See storeSegment()
+		return m_hasFixedCapacity
+			&& (segmentsCount () >= m_capacity.segments || m_graph.reservedNodesCount () < static_cast<int>(m_intersectedTrapezoids.size ()) * 2 + 4);
 	}
 
 	template<class Scalar>
@@ -107,8 +333,8 @@ namespace GAS
 		Trapezoid trapezoid;
 		trapezoid.left () = &bottomLeft ();
 		trapezoid.right () = &bottomRight ();
-		trapezoid.top () = &m_top;
-		trapezoid.bottom () = &m_bottom;
+		trapezoid.top () = &m_bounds->top;
+		trapezoid.bottom () = &m_bounds->bottom;
 		createTrapezoid (trapezoid);
 	}
 
@@ -121,6 +347,7 @@ namespace GAS
 	template<class Scalar>
 	Trapezoid<Scalar> &TrapezoidalMap<Scalar>::createTrapezoid (const Trapezoid &_copy)
 	{
+		count (&TrapezoidalMapStats::createdTrapezoids);
 		return m_graph.createLeaf (_copy).data ().second ();
 	}
 
@@ -130,6 +357,7 @@ namespace GAS
 		Node &node { getNode (_trapezoid) };
 		m_graph.setInner (node, getNode (_left), getNode (_right));
 		node.data () = _x;
+		count (&TrapezoidalMapStats::verticalSplits);
 	}
 
 	template<class Scalar>
@@ -138,36 +366,105 @@ namespace GAS
 		Node &node { getNode (_trapezoid) };
 		m_graph.setInner (node, getNode (_left), getNode (_right));
 		node.data () = _segment;
+		count (&TrapezoidalMapStats::horizontalSplits);
 	}
 
 	template<class Scalar>
-	TrapezoidalMap<Scalar>::TrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight)
+	TrapezoidalMap<Scalar>::TrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight, Utils::MemoryResource &_resource)
+		: m_segments { _resource }, m_points { _resource }, m_graph { _resource }, m_intersectedTrapezoids (Utils::ResourceAllocator<Trapezoid *> { _resource }),
+		m_bounds { Utils::allocateUnique<Bounds> (_resource) }
 	{
 		setBounds (_bottomLeft, _topRight);
 		initialize ();
 	}
 
 	template<class Scalar>
-	TrapezoidalMap<Scalar>::TrapezoidalMap (TrapezoidalMap &&_moved)
-		: m_bottom { _moved.m_bottom }, m_top { _moved.m_top }, m_graph { std::move (_moved.m_graph) }, m_segments { std::move (_moved.m_segments) }
+	TrapezoidalMap<Scalar>::TrapezoidalMap (const PointS &_bottomLeft, const PointS &_topRight, const TrapezoidalMapCapacity &_capacity, Utils::MemoryResource &_resource)
+		: TrapezoidalMap { _bottomLeft, _topRight, _resource }
 	{
-		_moved.clear ();
+		if (_capacity.segments < 0)
+		{
+			throw std::invalid_argument ("Segment capacity must not be negative");
+		}
+		if (_capacity.nodes < 1)
+		{
+			throw std::invalid_argument ("Node capacity must be positive");
+		}
+		m_capacity = _capacity;
+		m_hasFixedCapacity = true;
+		reserveCapacity ();
 	}
 
 	template<class Scalar>
-	TrapezoidalMap<Scalar> &TrapezoidalMap<Scalar>::operator=(TrapezoidalMap &&_moved)
+	TrapezoidalMap<Scalar>::TrapezoidalMap (const TrapezoidalMap &_copy)
 	{
-		clear ();
-		m_bottom = _moved.m_bottom;
-		m_top = _moved.m_top;
-		m_graph = std::move (_moved.m_graph);
-		m_segments = std::move (_moved.m_segments);
-		_moved.clear ();
+		clone (_copy, nullptr);
+	}
+
+	template<class Scalar>
+	TrapezoidalMap<Scalar>::TrapezoidalMap (const TrapezoidalMap &_copy, Utils::ThreadPool &_pool)
+	{
+		clone (_copy, &_pool);
+	}
+
+	template<class Scalar>
+	TrapezoidalMap<Scalar> &TrapezoidalMap<Scalar>::operator=(const TrapezoidalMap &_copy)
+	{
+		if (this != &_copy)
+		{
+			clone (_copy, nullptr);
+		}
+		return *this;
+	}
+
+	template<class Scalar>
+	TrapezoidalMap<Scalar>::TrapezoidalMap (TrapezoidalMap &&_moved) noexcept
+		: m_segments { std::move (_moved.m_segments) }, m_points { std::move (_moved.m_points) }, m_version { _moved.m_version + 1 },
+		m_graph { std::move (_moved.m_graph) }, m_intersectedTrapezoids { std::move (_moved.m_intersectedTrapezoids) },
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+		m_stats (_moved.m_stats),
+#endif
+		m_capacity (_moved.m_capacity), m_hasFixedCapacity { _moved.m_hasFixedCapacity }, m_bounds { std::move (_moved.m_bounds) }, m_movedBounds (_moved.m_movedBounds)
+	{
+		// Allocating the first trapezoid of the moved map is left to restore()
+		if (m_bounds)
+		{
+			_moved.m_movedBounds = *m_bounds;
+		}
+		_moved.m_version++;
+	}
+
+	template<class Scalar>
+	TrapezoidalMap<Scalar> &TrapezoidalMap<Scalar>::operator=(TrapezoidalMap &&_moved) noexcept
+	{
+		// The current content is destroyed along with the temporary, and self-assignment is harmless
+		TrapezoidalMap moved { std::move (_moved) };
+		swap (moved);
+		return *this;
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::swap (TrapezoidalMap &_other) noexcept
+	{
+		m_bounds.swap (_other.m_bounds);
+		std::swap (m_movedBounds, _other.m_movedBounds);
+		m_segments.swap (_other.m_segments);
+		m_points.swap (_other.m_points);
+		m_graph.swap (_other.m_graph);
+		m_intersectedTrapezoids.swap (_other.m_intersectedTrapezoids);
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+		std::swap (m_stats, _other.m_stats);
+#endif
+		std::swap (m_capacity, _other.m_capacity);
+		std::swap (m_hasFixedCapacity, _other.m_hasFixedCapacity);
+		// Hints are bound to the map address, so they must not match the swapped content
+		m_version = _other.m_version = std::max (m_version, _other.m_version) + 1;
 	}
 
 	template<class Scalar>
 	const TDAG::Node<Scalar> &TrapezoidalMap<Scalar>::root () const
 	{
+		checkNotMoved ();
 		return *m_graph.nodes ().begin ();
 	}
 
@@ -177,6 +474,44 @@ namespace GAS
 		return m_graph.leafNodesCount ();
 	}
 
+	template<class Scalar>
+	int TrapezoidalMap<Scalar>::segmentsCount () const
+	{
+		return static_cast<int>(m_segments.size ());
+	}
+
+	template<class Scalar>
+	TrapezoidalMapMemoryUsage TrapezoidalMap<Scalar>::memoryUsage () const
+	{
+		TrapezoidalMapMemoryUsage usage;
+		usage.object = sizeof (TrapezoidalMap);
+		usage.innerNodes = static_cast<std::size_t>(m_graph.innerNodesCount ()) * sizeof (Node);
+		usage.leafNodes = static_cast<std::size_t>(m_graph.leafNodesCount ()) * sizeof (Node);
+		usage.segments = m_segments.memoryUsage ();
+		usage.points = m_points.memoryUsage ();
+		usage.auxiliary = m_intersectedTrapezoids.capacity () * sizeof (Trapezoid *) + static_cast<std::size_t>(m_graph.reservedNodesCount ()) * sizeof (Node);
+		return usage;
+	}
+
+	template<class Scalar>
+	Utils::MemoryResource &TrapezoidalMap<Scalar>::resource () const
+	{
+		return m_graph.resource ();
+	}
+
+	template<class Scalar>
+	bool TrapezoidalMap<Scalar>::hasFixedCapacity () const
+	{
+		return m_hasFixedCapacity;
+	}
+
+	template<class Scalar>
+	const TrapezoidalMapCapacity &TrapezoidalMap<Scalar>::capacity () const
+	{
+		assert (m_hasFixedCapacity);
+		return m_capacity;
+	}
+
 	template<class Scalar>
 	TDAG::Utils::ConstTrapezoidIterator<Scalar> TrapezoidalMap<Scalar>::begin () const
 	{
@@ -193,59 +528,124 @@ namespace GAS
 	template<class QueryScalar>
 	const Trapezoid<Scalar> &TrapezoidalMap<Scalar>::query (const Point<QueryScalar> &_point) const
 	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::query");
 		if (!isPointInsideBounds (Geometry::cast<Scalar> (_point)))
 		{
 			throw std::invalid_argument ("Point is outside bounds");
 		}
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+		count (&TrapezoidalMapStats::queries);
+		// The walker is called on the inner nodes only, so the leaf is counted here
+		count (&TrapezoidalMapStats::visitedNodes);
+		return BDAG::walk (root (), [&](const NodeData &_data) {
+			count (&TrapezoidalMapStats::visitedNodes);
+			return TDAG::Utils::getPointQueryNextChild (_data.first (), _point, TDAG::Utils::disambiguateAlwaysRight);
+		}).data ().second ();
+#else
 		return TDAG::query (root (), _point);
+#endif
+	}
+
+	template<class Scalar>
+	template<class QueryScalar>
+	TDAG::QueryExplanation<Scalar> TrapezoidalMap<Scalar>::explainQuery (const Point<QueryScalar> &_point) const
+	{
+		if (!isPointInsideBounds (Geometry::cast<Scalar> (_point)))
+		{
+			throw std::invalid_argument ("Point is outside bounds");
+		}
+		return TDAG::explainQuery (root (), _point);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	TDAG::ShapeAnalysis TrapezoidalMap<Scalar>::analyzeShape () const
+	{
+		return TDAG::analyzeShape<Scalar, ArithmeticScalar> (root ());
 	}
 
 	template<class Scalar>
 	const Point<Scalar> &TrapezoidalMap<Scalar>::bottomLeft () const
 	{
-		return m_bottom.p1 ();
+		return bounds ().bottom.p1 ();
 	}
 
 	template<class Scalar>
 	const Point<Scalar> &TrapezoidalMap<Scalar>::bottomRight () const
 	{
-		return m_bottom.p2 ();
+		return bounds ().bottom.p2 ();
 	}
 
 	template<class Scalar>
 	const Point<Scalar> &TrapezoidalMap<Scalar>::topLeft () const
 	{
-		return m_top.p1 ();
+		return bounds ().top.p1 ();
 	}
 
 	template<class Scalar>
 	const Point<Scalar> &TrapezoidalMap<Scalar>::topRight () const
 	{
-		return m_top.p2 ();
+		return bounds ().top.p2 ();
 	}
 
 	template<class Scalar>
 	Scalar TrapezoidalMap<Scalar>::leftX () const
 	{
-		return m_bottom.p1 ().x ();
+		return bounds ().bottom.p1 ().x ();
 	}
 
 	template<class Scalar>
 	Scalar TrapezoidalMap<Scalar>::rightX () const
 	{
-		return m_bottom.p2 ().x ();
+		return bounds ().bottom.p2 ().x ();
 	}
 
 	template<class Scalar>
 	Scalar TrapezoidalMap<Scalar>::bottomY () const
 	{
-		return m_bottom.p1 ().y ();
+		return bounds ().bottom.p1 ().y ();
 	}
 
 	template<class Scalar>
 	Scalar TrapezoidalMap<Scalar>::topY () const
 	{
-		return m_top.p1 ().y ();
+		return bounds ().top.p1 ().y ();
+	}
+
+	template<class Scalar>
+	const typename TrapezoidalMap<Scalar>::Bounds &TrapezoidalMap<Scalar>::bounds () const
+	{
+		return m_bounds ? *m_bounds : m_movedBounds;
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::checkNotMoved () const
+	{
+		if (!m_bounds)
+		{
+			throw std::logic_error ("Map has been moved");
+		}
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::restore ()
+	{
+		if (m_bounds)
+		{
+			return;
+		}
+		m_bounds = Utils::allocateUnique<Bounds> (resource (), m_movedBounds);
+		try
+		{
+			initialize ();
+			reserveCapacity ();
+		}
+		catch (...)
+		{
+			destroy ();
+			m_bounds.reset ();
+			throw;
+		}
 	}
 
 	template<class Scalar>
@@ -266,8 +666,9 @@ namespace GAS
 				throw std::invalid_argument ("Not all segments are inside the new bounds");
 			}
 		}
-		m_bottom.set (_bottomLeft, { _topRight.x (), _bottomLeft.y () });
-		m_top.set ({ _bottomLeft.x (), _topRight.y () }, _topRight);
+		restore ();
+		m_bounds->bottom.set (_bottomLeft, { _topRight.x (), _bottomLeft.y () });
+		m_bounds->top.set ({ _bottomLeft.x (), _topRight.y () }, _topRight);
 	}
 
 	template<class Scalar>
@@ -283,49 +684,364 @@ namespace GAS
 	}
 
 	template<class Scalar>
-	const std::forward_list<Segment<Scalar>> &TrapezoidalMap<Scalar>::segments () const
+	const Utils::ChunkedStorage<Segment<Scalar>> &TrapezoidalMap<Scalar>::segments () const
 	{
 		return m_segments;
 	}
 
 	template<class Scalar>
 	template<class ArithmeticScalar>
-	void TrapezoidalMap<Scalar>::addSegment (const SegmentS &_segment)
+	EAddSegmentResult TrapezoidalMap<Scalar>::validateSegment (const SegmentS &_segment, SegmentS &_sortedSegment, Trapezoid *&_leftmost, const InsertionHint &_hint, TrapezoidList *_intersected) const
 	{
-		assert (!m_graph.isEmpty ());
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::validateSegment");
 		if (Geometry::isSegmentDegenerate (_segment))
 		{
-			throw std::invalid_argument ("Segment is degenerate");
+			return EAddSegmentResult::Degenerate;
 		}
 		if (Geometry::isSegmentVertical (_segment))
 		{
-			throw std::invalid_argument ("Segment is vertical");
+			return EAddSegmentResult::Vertical;
 		}
 		if (!isSegmentInsideBounds (_segment))
 		{
-			throw std::invalid_argument ("Segment is not completely inside bounds");
+			return EAddSegmentResult::OutOfBounds;
 		}
 		// Sort segment endpoints
-		SegmentS sortedSegment { Geometry::sortSegmentPointsHorizontally (_segment) };
+		_sortedSegment = Geometry::sortSegmentPointsHorizontally (_segment);
 		// Find the first trapezoid to replace
-		Trapezoid &firstTrapezoid { findLeftmostIntersectedTrapezoid<ArithmeticScalar> (sortedSegment) };
+		_leftmost = findLeftmostIntersectedTrapezoid<ArithmeticScalar> (_sortedSegment, _hint);
+		if (_leftmost)
+		{
+			count (&TrapezoidalMapStats::hintedSegments);
+		}
+		else
+		{
+			EAddSegmentResult result;
+			_leftmost = findLeftmostIntersectedTrapezoid<ArithmeticScalar> (_sortedSegment, result);
+			if (result != EAddSegmentResult::Added)
+			{
+				return result;
+			}
+		}
 		// Check if there are intersections
-		if (doesSegmentIntersect<ArithmeticScalar> (sortedSegment, firstTrapezoid))
+		return collectIntersectedTrapezoids<ArithmeticScalar> (_sortedSegment, *_leftmost, true, _intersected);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult TrapezoidalMap<Scalar>::checkSegment (const SegmentS &_segment) const
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::checkSegment");
+		checkNotMoved ();
+		SegmentS sortedSegment { _segment };
+		Trapezoid *leftmost {};
+		return validateSegment<ArithmeticScalar> (_segment, sortedSegment, leftmost, InsertionHint {}, nullptr);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult TrapezoidalMap<Scalar>::checkSegment (const SegmentS &_segment, PreparedSegment &_prepared) const
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::checkSegment");
+		checkNotMoved ();
+		_prepared.m_map = this;
+		Trapezoid *leftmost {};
+		return validateSegment<ArithmeticScalar> (_segment, _prepared.m_segment, leftmost, InsertionHint {}, &_prepared.m_intersected);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	void TrapezoidalMap<Scalar>::addPreparedSegment (const PreparedSegment &_prepared)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::addPreparedSegment");
+		assert (_prepared.m_map == this && !_prepared.m_intersected.empty ());
+		// Adding segments only changes the neighbors of the trapezoids that are not split, so if all of them are still leaves they still tile the segment
+		bool stale { false };
+		for (Trapezoid *trapezoid : _prepared.m_intersected)
+		{
+			if (!getNode (*trapezoid).isLeaf ())
+			{
+				stale = true;
+				break;
+			}
+		}
+		if (stale)
+		{
+			EAddSegmentResult result;
+			Trapezoid *const leftmost { findLeftmostIntersectedTrapezoid<ArithmeticScalar> (_prepared.m_segment, result) };
+			assert (result == EAddSegmentResult::Added);
+			collectIntersectedTrapezoids<ArithmeticScalar> (_prepared.m_segment, *leftmost, false, &m_intersectedTrapezoids);
+		}
+		else
+		{
+			m_intersectedTrapezoids.assign (_prepared.m_intersected.begin (), _prepared.m_intersected.end ());
+		}
+		addCollectedSegment (_prepared.m_segment);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	void TrapezoidalMap<Scalar>::addSegment (const SegmentS &_segment)
+	{
+		const EAddSegmentResult result { tryAddSegment<ArithmeticScalar> (_segment) };
+		if (result != EAddSegmentResult::Added)
 		{
-			throw std::invalid_argument ("Segment intersects some other segment in the map");
+			throw std::invalid_argument (getAddSegmentResultMessage (result));
+		}
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult TrapezoidalMap<Scalar>::tryAddSegment (const SegmentS &_segment)
+	{
+		InsertionHint hint;
+		return tryAddSegment<ArithmeticScalar> (_segment, hint);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult TrapezoidalMap<Scalar>::tryAddSegment (const SegmentS &_segment, InsertionHint &_hint)
+	{
+		return insertSegment<ArithmeticScalar> (_segment, _hint, nullptr, nullptr);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	EAddSegmentResult TrapezoidalMap<Scalar>::insertSegment (const SegmentS &_segment, InsertionHint &_hint, const PointS *_p1, const PointS *_p2)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::addSegment");
+		restore ();
+		SegmentS sortedSegment { _segment };
+		Trapezoid *firstTrapezoid {};
+		EAddSegmentResult result { validateSegment<ArithmeticScalar> (_segment, sortedSegment, firstTrapezoid, _hint, &m_intersectedTrapezoids) };
+		if (result == EAddSegmentResult::Added && isCapacityExceeded ())
+		{
+			result = EAddSegmentResult::CapacityExceeded;
+		}
+		if (result != EAddSegmentResult::Added)
+		{
+			countRejection (result);
+			return result;
 		}
 		// Store segment
-		m_segments.push_front (sortedSegment);
-		const SegmentS &segment { m_segments.front () };
+		const bool swapped { sortedSegment.p1 () != _segment.p1 () };
+		const PointS *left { swapped ? _p2 : _p1 }, *right { swapped ? _p1 : _p2 };
+		const SegmentS &segment { storeSegment (sortedSegment, left, right) };
 		// Update map
-		updateForNewSegment<ArithmeticScalar> (segment, firstTrapezoid);
+		_hint = updateForNewSegment (segment, *left, *right);
+		_hint.m_map = this;
+		_hint.m_version = m_version;
+		count (&TrapezoidalMapStats::insertedSegments);
+		return EAddSegmentResult::Added;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator>
+	std::vector<EAddSegmentResult> TrapezoidalMap<Scalar>::tryAddSegments (Iterator _first, Iterator _last)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::tryAddSegments");
+		std::vector<EAddSegmentResult> results;
+		// Consecutive segments often share an endpoint
+		InsertionHint hint;
+		for (; _first != _last; ++_first)
+		{
+			results.push_back (tryAddSegment<ArithmeticScalar> (*_first, hint));
+		}
+		return results;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator>
+	void TrapezoidalMap<Scalar>::addPolyline (Iterator _first, Iterator _last)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::addPolyline");
+		if (_first == _last)
+		{
+			return;
+		}
+		InsertionHint hint;
+		PointS previous { *_first };
+		for (++_first; _first != _last; ++_first)
+		{
+			const PointS current { *_first };
+			const EAddSegmentResult result { tryAddSegment<ArithmeticScalar> (SegmentS { previous, current }, hint) };
+			if (result != EAddSegmentResult::Added)
+			{
+				throw std::invalid_argument (getAddSegmentResultMessage (result));
+			}
+			previous = current;
+		}
+	}
+
+	template<class Scalar>
+	const Segment<Scalar> &TrapezoidalMap<Scalar>::storeSegment (const SegmentS &_sortedSegment, const PointS *&_left, const PointS *&_right)
+	{
+		assert (Geometry::areSegmentPointsHorizzontallySorted (_sortedSegment));
+		assert (!m_intersectedTrapezoids.empty ());
+		// Splitting the crossed trapezoids creates at most two leaves each, plus two for each vertical split at the endpoints
+		// Allocating them in advance ensures that a failed allocation cannot leave the map half updated
+		m_graph.reserve (static_cast<int>(m_intersectedTrapezoids.size ()) * 2 + 4);
+		const SegmentS &segment { m_segments.pushBack (_sortedSegment) };
+		m_version++;
+		// An endpoint already in the map must be the left point of the leftmost trapezoid or the right point of the rightmost one
+		// New endpoints are referenced directly inside the stored segment
+		if (!_left)
+		{
+			const PointS *existing { m_intersectedTrapezoids.front ()->left () };
+			_left = *existing == segment.p1 () ? existing : &segment.p1 ();
+		}
+		if (!_right)
+		{
+			const PointS *existing { m_intersectedTrapezoids.back ()->right () };
+			_right = *existing == segment.p2 () ? existing : &segment.p2 ();
+		}
+		assert (*_left == segment.p1 () && *_right == segment.p2 ());
+		return segment;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class PointIterator, class IndexIterator>
+	std::vector<EAddSegmentResult> TrapezoidalMap<Scalar>::tryAddIndexedSegments (PointIterator _pointsFirst, PointIterator _pointsLast, IndexIterator _segmentsFirst, IndexIterator _segmentsLast)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::tryAddIndexedSegments");
+		// Copy the points into the shared table
+		const std::size_t offset { m_points.size () };
+		try
+		{
+			for (; _pointsFirst != _pointsLast; ++_pointsFirst)
+			{
+				m_points.pushBack (*_pointsFirst);
+			}
+		}
+		catch (...)
+		{
+			while (m_points.size () > offset)
+			{
+				m_points.popBack ();
+			}
+			throw;
+		}
+		const std::size_t pointsCount { m_points.size () - offset };
+		// Check the indices before adding anything
+		std::vector<std::pair<std::size_t, std::size_t>> indices;
+		for (; _segmentsFirst != _segmentsLast; ++_segmentsFirst)
+		{
+			const std::size_t i1 { static_cast<std::size_t>(_segmentsFirst->first) }, i2 { static_cast<std::size_t>(_segmentsFirst->second) };
+			if (i1 >= pointsCount || i2 >= pointsCount)
+			{
+				while (m_points.size () > offset)
+				{
+					m_points.popBack ();
+				}
+				throw std::invalid_argument ("Point index out of range");
+			}
+			indices.emplace_back (offset + i1, offset + i2);
+		}
+		// Add the segments
+		std::vector<EAddSegmentResult> results;
+		results.reserve (indices.size ());
+		InsertionHint hint;
+		for (const std::pair<std::size_t, std::size_t> &index : indices)
+		{
+			const PointS &p1 { m_points[index.first] }, &p2 { m_points[index.second] };
+			results.push_back (insertSegment<ArithmeticScalar> (SegmentS { p1, p2 }, hint, &p1, &p2));
+		}
+		return results;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	void TrapezoidalMap<Scalar>::addSegmentUnchecked (const SegmentS &_segment)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::addSegmentUnchecked");
+		restore ();
+		SegmentS sortedSegment { _segment };
+		Trapezoid *firstTrapezoid {};
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_UNCHECKED_VERIFICATION
+		const EAddSegmentResult result { validateSegment<ArithmeticScalar> (_segment, sortedSegment, firstTrapezoid, InsertionHint {}, &m_intersectedTrapezoids) };
+		if (result != EAddSegmentResult::Added)
+		{
+			countRejection (result);
+			throw std::invalid_argument (getAddSegmentResultMessage (result));
+		}
+#else
+		assert (!Geometry::isSegmentDegenerate (_segment));
+		assert (!Geometry::isSegmentVertical (_segment));
+		assert (isSegmentInsideBounds (_segment));
+		// Sort segment endpoints
+		sortedSegment = Geometry::sortSegmentPointsHorizontally (_segment);
+		// Find the first trapezoid to replace
+		EAddSegmentResult result;
+		firstTrapezoid = findLeftmostIntersectedTrapezoid<ArithmeticScalar> (sortedSegment, result);
+		assert (result == EAddSegmentResult::Added);
+		// Find the other trapezoids to replace
+		collectIntersectedTrapezoids<ArithmeticScalar> (sortedSegment, *firstTrapezoid, false, &m_intersectedTrapezoids);
+#endif
+		addCollectedSegment (sortedSegment);
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::addCollectedSegment (const SegmentS &_sortedSegment)
+	{
+		if (isCapacityExceeded ())
+		{
+			countRejection (EAddSegmentResult::CapacityExceeded);
+			throw std::invalid_argument (getAddSegmentResultMessage (EAddSegmentResult::CapacityExceeded));
+		}
+		// Store segment
+		const PointS *left {}, *right {};
+		const SegmentS &segment { storeSegment (_sortedSegment, left, right) };
+		// Update map
+		updateForNewSegment (segment, *left, *right);
+		count (&TrapezoidalMapStats::insertedSegments);
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar, class Iterator>
+	void TrapezoidalMap<Scalar>::addSegmentsUnchecked (Iterator _first, Iterator _last)
+	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::addSegmentsUnchecked");
+		for (; _first != _last; ++_first)
+		{
+			addSegmentUnchecked<ArithmeticScalar> (*_first);
+		}
 	}
 
 	template<class Scalar>
 	void TrapezoidalMap<Scalar>::clear ()
 	{
-		destroy ();
-		initialize ();
+		if (m_bounds)
+		{
+			destroy ();
+			initialize ();
+		}
+		else
+		{
+			restore ();
+		}
+		m_version++;
+	}
+
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+
+	template<class Scalar>
+	TrapezoidalMapStats TrapezoidalMap<Scalar>::stats () const
+	{
+		return m_stats;
+	}
+
+	template<class Scalar>
+	void TrapezoidalMap<Scalar>::resetStats ()
+	{
+		m_stats = {};
+	}
+
+#endif
+
+	template<class Scalar>
+	void swap (TrapezoidalMap<Scalar> &_a, TrapezoidalMap<Scalar> &_b) noexcept
+	{
+		_a.swap (_b);
 	}
 
 }
@@ -110,19 +110,18 @@ namespace GAS
 
 	template<class Scalar>
 	template<class ArithmeticScalar>
-	ArithmeticScalar TrapezoidalMap<Scalar>::evalLineOnRightEdge (const SegmentS &_line, const Trapezoid &_trapezoid)
-	{
-		const ArithmeticScalar &x { static_cast<ArithmeticScalar> (_trapezoid.rightX ()) };
-		return Geometry::evalLine (Geometry::cast<ArithmeticScalar> (_line), x);
-	}
-
-	template<class Scalar>
-	template<class ArithmeticScalar>
-	Trapezoid<Scalar> &TrapezoidalMap<Scalar>::findLeftmostIntersectedTrapezoid (const SegmentS &_segment)
+	Trapezoid<Scalar> *TrapezoidalMap<Scalar>::findLeftmostIntersectedTrapezoid (const SegmentS &_segment, EAddSegmentResult &_result) const
 	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::findLeftmostIntersectedTrapezoid");
 		assert (Geometry::areSegmentPointsHorizzontallySorted (_segment));
 		const PointS &left { _segment.p1 () }, &right { _segment.p2 () };
-		return BDAG::walk (root (), [&](const TDAG::NodeData<Scalar> &_data) {
+		_result = EAddSegmentResult::Added;
+		const Trapezoid &leftmost { BDAG::walk (root (), [&](const TDAG::NodeData<Scalar> &_data) {
+			// Once rejected, just reach any leaf
+			if (_result != EAddSegmentResult::Added)
+			{
+				return TDAG::EChild::Left;
+			}
 			const TDAG::Split<Scalar> &split { _data.first () };
 			if (split.type () == TDAG::ESplitType::NonVertical)
 			{
@@ -137,7 +136,8 @@ namespace GAS
 						// If two segments share the same left point
 						if (_segment == splitSegment)
 						{
-							throw std::invalid_argument ("Duplicate segments are illegal");
+							_result = EAddSegmentResult::Duplicate;
+							return TDAG::EChild::Left;
 						}
 						switch (Geometry::getPointSideWithSegment (Geometry::cast<ArithmeticScalar> (splitSegment), Geometry::cast<ArithmeticScalar> (right)))
 						{
@@ -148,14 +148,79 @@ namespace GAS
 							case Geometry::ESide::Right:
 								return TDAG::EChild::Right;
 							case Geometry::ESide::Collinear:
-								throw std::invalid_argument ("Overlapping segments are illegal");
+								_result = EAddSegmentResult::Overlapping;
+								return TDAG::EChild::Left;
 						}
 					}
-					throw std::invalid_argument ("Points with the same x-coordinate are illegal");
+					_result = EAddSegmentResult::SharedX;
+					return TDAG::EChild::Left;
 				}
 			}
 			return TDAG::Utils::getPointQueryNextChild (split, Geometry::cast<ArithmeticScalar> (left), TDAG::Utils::disambiguateAlwaysRight);
-		}).data ().second ();
+		}).data ().second () };
+		return _result == EAddSegmentResult::Added ? const_cast<Trapezoid *>(&leftmost) : nullptr;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	bool TrapezoidalMap<Scalar>::isSegmentStartingInside (const SegmentS &_segment, const Trapezoid &_trapezoid)
+	{
+		assert (Geometry::areSegmentPointsHorizzontallySorted (_segment));
+		if (*_trapezoid.left () != _segment.p1 ())
+		{
+			return false;
+		}
+		const Point<ArithmeticScalar> &left { Geometry::cast<ArithmeticScalar> (_segment.p1 ()) }, &right { Geometry::cast<ArithmeticScalar> (_segment.p2 ()) };
+		// The segment must start above the bottom segment, or leave it upwards if they share the left endpoint
+		{
+			const Segment<ArithmeticScalar> &bottom { Geometry::cast<ArithmeticScalar> (*_trapezoid.bottom ()) };
+			const Geometry::ESide side { Geometry::getPointSideWithSegment (bottom, left) };
+			if (side == Geometry::ESide::Right || (side == Geometry::ESide::Collinear && Geometry::getPointSideWithSegment (bottom, right) != Geometry::ESide::Left))
+			{
+				return false;
+			}
+		}
+		// The segment must start below the top segment, or leave it downwards if they share the left endpoint
+		{
+			const Segment<ArithmeticScalar> &top { Geometry::cast<ArithmeticScalar> (*_trapezoid.top ()) };
+			const Geometry::ESide side { Geometry::getPointSideWithSegment (top, left) };
+			if (side == Geometry::ESide::Left || (side == Geometry::ESide::Collinear && Geometry::getPointSideWithSegment (top, right) != Geometry::ESide::Right))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	template<class Scalar>
+	template<class ArithmeticScalar>
+	Trapezoid<Scalar> *TrapezoidalMap<Scalar>::findLeftmostIntersectedTrapezoid (const SegmentS &_segment, const InsertionHint &_hint) const
+	{
+		assert (Geometry::areSegmentPointsHorizzontallySorted (_segment));
+		if (_hint.m_map != this || _hint.m_version != m_version)
+		{
+			return nullptr;
+		}
+		const PointS &left { _segment.p1 () };
+		Trapezoid *candidates[2] {};
+		if (left == _hint.m_segment->p2 ())
+		{
+			candidates[0] = _hint.m_rightBottom;
+			candidates[1] = _hint.m_rightTop;
+		}
+		else if (left == _hint.m_segment->p1 ())
+		{
+			candidates[0] = _hint.m_leftBottom;
+			candidates[1] = _hint.m_leftTop;
+		}
+		for (Trapezoid *candidate : candidates)
+		{
+			if (candidate && isSegmentStartingInside<ArithmeticScalar> (_segment, *candidate))
+			{
+				return candidate;
+			}
+		}
+		return nullptr;
 	}
 
 	template<class Scalar>
@@ -182,6 +247,7 @@ namespace GAS
 		// Create new trapezoids or merge left
 		const bool mergeBottom { _previous && _trapezoid.bottom () == _previous.bottom ().bottom () && &_segment == _previous.bottom ().top () };
 		const bool mergeTop { _previous && _trapezoid.top () == _previous.top ().top () && &_segment == _previous.top ().bottom () };
+		count (&TrapezoidalMapStats::merges, mergeBottom + mergeTop);
 		Trapezoid &bottom { mergeBottom ? _previous.bottom () : createTrapezoid (_trapezoid) };
 		Trapezoid &top { mergeTop ? _previous.top () : createTrapezoid (_trapezoid) };
 		bottom.top () = top.bottom () = &_segment;
@@ -213,97 +279,144 @@ namespace GAS
 		{
 			weld ({ _previous.top (), _previous.top () }, { top, top });
 		}
+		if (_previous)
+		{
+			count (&TrapezoidalMapStats::welds);
+		}
 		// Update DAG
 		splitTrapezoid (_trapezoid, _segment, top, bottom);
 		return { bottom, top };
 	}
 
 	template<class Scalar>
-	template<class ArithmeticScalar>
-	void TrapezoidalMap<Scalar>::updateForNewSegment (const SegmentS &_segment, Trapezoid &_leftmost)
+	typename TrapezoidalMap<Scalar>::InsertionHint TrapezoidalMap<Scalar>::updateForNewSegment (const SegmentS &_segment, const PointS &_left, const PointS &_right)
 	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::updateForNewSegment");
 		assert (Geometry::areSegmentPointsHorizzontallySorted (_segment));
+		assert (!m_intersectedTrapezoids.empty ());
+		assert (_left == _segment.p1 () && _right == _segment.p2 ());
+		InsertionHint hint;
+		hint.m_segment = &_segment;
 		Trapezoid *current;
 		// Left vertical split
 		{
-			const PointS &left { _segment.p1 () };
-			assert (left.x () >= _leftmost.left ()->x ());
-			if (left.x () > _leftmost.left ()->x ())
+			const PointS &left { _left };
+			Trapezoid &leftmost { *m_intersectedTrapezoids.front () };
+			assert (left.x () >= leftmost.left ()->x ());
+			if (left.x () > leftmost.left ()->x ())
 			{
-				Pair split { splitVertically (_leftmost, left) };
+				Pair split { splitVertically (leftmost, left) };
 				current = &split.right ();
 			}
 			else
 			{
-				assert (left.y () == _leftmost.left ()->y ());
-				current = &_leftmost;
+				assert (left.y () == leftmost.left ()->y ());
+				current = &leftmost;
 			}
 		}
 		// Horizontal split
 		{
-			const PointS &right { _segment.p2 () };
+			const PointS &right { _right };
 			NullablePair previous { NullablePair::allOrNone (current->lowerLeftNeighbor (), current->upperLeftNeighbor ()) };
-			NullablePair next { NullablePair::allOrNone (current->lowerRightNeighbor (), current->upperRightNeighbor ()) };
-			while (current && right.x () > current->left ()->x ())
+			NullablePair next { NullablePair::null };
+			const std::size_t crossed { m_intersectedTrapezoids.size () };
+			for (std::size_t i {}; i < crossed; i++)
 			{
+				if (i > 0)
+				{
+					current = m_intersectedTrapezoids[i];
+				}
+				assert (right.x () > current->left ()->x ());
 				// Split vertically if _segment ends inside current trapezoid
 				if (right.x () < current->right ()->x ())
 				{
+					assert (i + 1 == crossed);
 					Pair split { splitVertically (*current, right) };
 					current = &split.left ();
 				}
-				// Split horizontally and find the next trapezoid
+				// Split horizontally
+				next = NullablePair::allOrNone (current->lowerRightNeighbor (), current->upperRightNeighbor ());
+				previous = incrementalSplitHorizontally (*current, _segment, previous);
+				if (i == 0)
 				{
-					// Decide whether to proceed splitting in the lower or the upper right neighbor before splitting
-					const bool segmentAboveRight { evalLineOnRightEdge (_segment, *current) > static_cast<ArithmeticScalar>(current->right ()->y ()) };
-					next = NullablePair::allOrNone (current->lowerRightNeighbor (), current->upperRightNeighbor ());
-					// Split
-					previous = incrementalSplitHorizontally (*current, _segment, previous);
-					current = next ? segmentAboveRight ? &next.top () : &next.bottom () : nullptr;
+					hint.m_leftBottom = &previous.bottom ();
+					hint.m_leftTop = &previous.top ();
 				}
 			}
+			count (&TrapezoidalMapStats::crossedTrapezoids, static_cast<long long>(crossed));
+#ifdef GAS_DATA_ENABLE_TRAPEZOIDAL_MAP_STATS
+			if (static_cast<long long>(crossed) > m_stats.maxCrossedTrapezoids)
+			{
+				m_stats.maxCrossedTrapezoids = static_cast<long long>(crossed);
+			}
+#endif
 			// Link last trapezoid
 			if (next)
 			{
 				weld (previous, next);
+				count (&TrapezoidalMapStats::welds);
+				hint.m_rightBottom = &next.bottom ();
+				hint.m_rightTop = &next.top ();
 			}
 		}
+		return hint;
 	}
 
 	template<class Scalar>
 	template<class ArithmeticScalar>
-	bool TrapezoidalMap<Scalar>::doesSegmentIntersect (const SegmentS &_segment, const Trapezoid &_leftmost) const
+	EAddSegmentResult TrapezoidalMap<Scalar>::collectIntersectedTrapezoids (const SegmentS &_segment, Trapezoid &_leftmost, bool _validate, TrapezoidList *_intersected) const
 	{
+		GAS_UTILS_TRACE_SPAN ("TrapezoidalMap::collectIntersectedTrapezoids");
 		assert (Geometry::areSegmentPointsHorizzontallySorted (_segment));
 		assert (isSegmentInsideBounds (_segment));
+		const Segment<ArithmeticScalar> &segment { Geometry::cast<ArithmeticScalar> (_segment) };
 		const PointS &right { _segment.p2 () };
-		const Trapezoid *current { &_leftmost };
+		Trapezoid *current { &_leftmost };
+		if (_intersected)
+		{
+			_intersected->clear ();
+			_intersected->push_back (current);
+		}
 		while (right.x () > current->rightX ())
 		{
-			const ArithmeticScalar y { evalLineOnRightEdge<ArithmeticScalar> (_segment, *current) };
-			if (y <= current->template bottomRight<ArithmeticScalar> ().y () ||
-				y == static_cast<ArithmeticScalar> (current->right ()->y ()) ||
-				y >= current->template topRight<ArithmeticScalar> ().y ())
+			// Decide whether to proceed in the lower or the upper right neighbor
+			const Geometry::ESide rightPointSide { Geometry::getPointSideWithSegment (segment, Geometry::cast<ArithmeticScalar> (*current->right ())) };
+			const bool segmentAboveRight { rightPointSide == Geometry::ESide::Right };
+			if (_validate)
 			{
-				return true;
+				const ArithmeticScalar x { static_cast<ArithmeticScalar> (current->rightX ()) };
+				if (rightPointSide == Geometry::ESide::Collinear
+					|| (segmentAboveRight
+						? Geometry::compareLinesAtX (segment, Geometry::cast<ArithmeticScalar> (*current->top ()), x) >= 0
+						: Geometry::compareLinesAtX (segment, Geometry::cast<ArithmeticScalar> (*current->bottom ()), x) <= 0))
+				{
+					return EAddSegmentResult::Intersecting;
+				}
 			}
-			const bool segmentAboveRight { y > static_cast<ArithmeticScalar>(current->right ()->y ()) };
 			current = segmentAboveRight ? current->upperRightNeighbor () : current->lowerRightNeighbor ();
-		}
-		if (right.x () < current->rightX ())
-		{
-			if (!current->contains (Geometry::cast<ArithmeticScalar> (right)))
+			assert (current);
+			if (_intersected)
 			{
-				return true;
+				_intersected->push_back (current);
 			}
 		}
-		else if (right != current->bottom ()->p2 ()
-			&& right != current->top ()->p2 ()
-			&& right.y () != current->right ()->y ())
+		if (_validate)
 		{
-			throw std::invalid_argument ("Points with the same x-coordinate are illegal");
+			if (right.x () < current->rightX ())
+			{
+				if (!current->contains (Geometry::cast<ArithmeticScalar> (right)))
+				{
+					return EAddSegmentResult::Intersecting;
+				}
+			}
+			else if (right != current->bottom ()->p2 ()
+				&& right != current->top ()->p2 ()
+				&& right.y () != current->right ()->y ())
+			{
+				return EAddSegmentResult::SharedX;
+			}
 		}
-		return false;
+		return EAddSegmentResult::Added;
 	}
 
 }
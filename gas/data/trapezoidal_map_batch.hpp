@@ -0,0 +1,58 @@
+/// Parallel construction of many independent GAS::TrapezoidalMap objects.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_DATA_TRAPEZOIDAL_MAP_BATCH_INCLUDED
+#define GAS_DATA_TRAPEZOIDAL_MAP_BATCH_INCLUDED
+
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <gas/utils/thread_pool.hpp>
+#include <memory>
+#include <vector>
+
+namespace GAS
+{
+
+	/// Input of a single map in a batch build.
+	/// \tparam Scalar
+	/// The scalar type.
+	template<class Scalar>
+	struct TrapezoidalMapTile
+	{
+		Point<Scalar> bottomLeft, topRight;		///< Map bounds.
+		std::vector<Segment<Scalar>> segments;	///< Segments to add, in order.
+	};
+
+	/// Output of a single map in a batch build.
+	/// \tparam Scalar
+	/// The scalar type.
+	template<class Scalar>
+	struct TrapezoidalMapTileResult
+	{
+		std::unique_ptr<TrapezoidalMap<Scalar>> map;	///< The built map, allocated once so that it never needs to be relocated.
+		std::vector<EAddSegmentResult> results;			///< The outcome of each segment, as returned by TrapezoidalMap::tryAddSegments().
+	};
+
+	/// Build a trapezoidal map for each tile, scheduling one task per tile on a thread pool through Utils::parallelFor().
+	/// \tparam Scalar
+	/// The scalar type.
+	/// \param[in] tiles
+	/// The tiles to build.
+	/// \param[in] pool
+	/// The pool running the builds.
+	/// \return
+	/// The built maps, in the same order of \p tiles.
+	/// \exception std::invalid_argument
+	/// If the bounds of a tile are invalid. The exception is rethrown only after every other build has finished.
+	/// \remark
+	/// The builds share no state, so the outcome does not depend on the number of threads or on their scheduling.
+	template<class Scalar>
+	std::vector<TrapezoidalMapTileResult<Scalar>> buildTrapezoidalMaps (const std::vector<TrapezoidalMapTile<Scalar>> &tiles, Utils::ThreadPool &pool);
+
+}
+
+#include "trapezoidal_map_batch.tpp"
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef GAS_DATA_TRAPEZOIDAL_MAP_BATCH_IMPL_INCLUDED
+#define GAS_DATA_TRAPEZOIDAL_MAP_BATCH_IMPL_INCLUDED
+
+#ifndef GAS_DATA_TRAPEZOIDAL_MAP_BATCH_INCLUDED
+#error 'gas/data/trapezoidal_map_batch.tpp' should not be directly included
+#endif
+
+#include "trapezoidal_map_batch.hpp"
+
+namespace GAS
+{
+
+	template<class Scalar>
+	std::vector<TrapezoidalMapTileResult<Scalar>> buildTrapezoidalMaps (const std::vector<TrapezoidalMapTile<Scalar>> &_tiles, Utils::ThreadPool &_pool)
+	{
+		GAS_UTILS_TRACE_SPAN ("buildTrapezoidalMaps");
+		std::vector<TrapezoidalMapTileResult<Scalar>> results (_tiles.size ());
+		// One tile per chunk, since the build times vary a lot
+		Utils::parallelFor (_pool, std::size_t {}, _tiles.size (), [&_tiles, &results] (std::size_t _first, std::size_t _last) {
+			for (std::size_t i { _first }; i < _last; i++)
+			{
+				GAS_UTILS_TRACE_SPAN ("buildTrapezoidalMaps::tile");
+				const TrapezoidalMapTile<Scalar> &tile { _tiles[i] };
+				TrapezoidalMapTileResult<Scalar> &result { results[i] };
+				result.map.reset (new TrapezoidalMap<Scalar> { tile.bottomLeft, tile.topRight });
+				result.results = result.map->tryAddSegments (tile.segments.begin (), tile.segments.end ());
+			}
+		}, 1);
+		return results;
+	}
+
+}
+
+#endif
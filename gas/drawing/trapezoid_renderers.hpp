@@ -9,6 +9,7 @@
 #include <gas/data/trapezoid.hpp>
 #include <cg3/viewer/glcanvas.h>
 #include <gas/drawing/color.hpp>
+#include <unordered_map>
 
 /// Backup and restore the OpenGL server state after drawing.
 /// If defined, the OpenGL server state is left untouched after drawing is finished.
@@ -126,7 +127,8 @@ namespace GAS
 
 			};
 
-			/// Renderer that draws an unique code inside each trapezoid.
+			/// Renderer that draws an unique code inside each trapezoid, followed by the codes of its neighbors.
+			/// The code is the trapezoid index in the map, or its serial if #GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL is defined.
 			/// \tparam Scalar
 			/// The scalar type of the input TrapezoidalMap.
 			/// \tparam RenderScalar
@@ -142,7 +144,12 @@ namespace GAS
 				QFontMetrics m_fontMetrics { m_font };
 
 #ifdef GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
-				static QString getTrapezoidSerial (const Trapezoid<Scalar> *trapezoid);
+				static QString getTrapezoidCode (const Trapezoid<Scalar> *trapezoid);
+#else
+				/// Trapezoid indices, valid between beforeDraw() and afterDraw().
+				mutable std::unordered_map<const Trapezoid<Scalar> *, int> m_indices;
+
+				QString getTrapezoidCode (const Trapezoid<Scalar> *trapezoid) const;
 #endif
 
 				static bool isRectInsideTrapezoid (const Point<RenderScalar> &center, RenderScalar halfWidth, RenderScalar halfHeight, const Trapezoid<Scalar> &trapezoid);
@@ -189,10 +189,16 @@ namespace GAS
 
 #ifdef GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
 			template<class Scalar, class RenderScalar>
-			QString Text<Scalar, RenderScalar>::getTrapezoidSerial (const Trapezoid<Scalar> *_trapezoid)
+			QString Text<Scalar, RenderScalar>::getTrapezoidCode (const Trapezoid<Scalar> *_trapezoid)
 			{
 				return QString::fromStdString (_trapezoid ? _trapezoid->serial () : GAS::Utils::Serial::null);
 			}
+#else
+			template<class Scalar, class RenderScalar>
+			QString Text<Scalar, RenderScalar>::getTrapezoidCode (const Trapezoid<Scalar> *_trapezoid) const
+			{
+				return _trapezoid ? QString::number (m_indices.at (_trapezoid)) : QString { "-" };
+			}
 #endif
 
 			template<class Scalar, class RenderScalar>
@@ -224,8 +230,20 @@ namespace GAS
 			}
 
 			template<class Scalar, class RenderScalar>
-			void Text<Scalar, RenderScalar>::beforeDraw (const TrapezoidalMap<Scalar> &/*_trapezoidalMap*/) const
+			void Text<Scalar, RenderScalar>::beforeDraw (const TrapezoidalMap<Scalar> &_trapezoidalMap) const
 			{
+#ifdef GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
+				(void)_trapezoidalMap;
+#else
+				// Same indices passed to draw() by TrapezoidalMapDrawer
+				m_indices.clear ();
+				m_indices.reserve (static_cast<std::size_t>(_trapezoidalMap.trapezoidsCount ()));
+				int i {};
+				for (const Trapezoid<Scalar> &trapezoid : _trapezoidalMap)
+				{
+					m_indices.emplace (&trapezoid, i++);
+				}
+#endif
 #ifdef GAS_DRAWING_RESTORE_GL_STATE
 				glPushAttrib (GL_ENABLE_BIT);
 #endif
@@ -246,16 +264,17 @@ namespace GAS
 					const Point<Scalar> centroid { _trapezoid.centroid () };
 #ifdef GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
 					(void)_index;
+					const QString self { getTrapezoidCode (&_trapezoid) };
+#else
+					const QString self { QString::number (_index) };
+#endif
 					QString text { QString { "%1 (%2 %3 %4 %5)" }
-						.arg (getTrapezoidSerial (&_trapezoid))
-						.arg (getTrapezoidSerial (_trapezoid.lowerLeftNeighbor ()))
-						.arg (getTrapezoidSerial (_trapezoid.upperLeftNeighbor ()))
-						.arg (getTrapezoidSerial (_trapezoid.upperRightNeighbor ()))
-						.arg (getTrapezoidSerial (_trapezoid.lowerRightNeighbor ()))
+						.arg (self)
+						.arg (getTrapezoidCode (_trapezoid.lowerLeftNeighbor ()))
+						.arg (getTrapezoidCode (_trapezoid.upperLeftNeighbor ()))
+						.arg (getTrapezoidCode (_trapezoid.upperRightNeighbor ()))
+						.arg (getTrapezoidCode (_trapezoid.lowerRightNeighbor ()))
 					};
-#else
-					QString text { QString::number (_index) };
-#endif 
 					drawText (text, _trapezoid);
 				}
 			}
@@ -263,6 +282,9 @@ namespace GAS
 			template<class Scalar, class RenderScalar>
 			void Text<Scalar, RenderScalar>::afterDraw (const TrapezoidalMap<Scalar> &/*_trapezoidalMap*/) const
 			{
+#ifndef GAS_DRAWING_ENABLE_TRAPEZOID_SERIAL
+				m_indices.clear ();
+#endif
 #ifdef GAS_DRAWING_RESTORE_GL_STATE
 				glPopAttrib ();
 #endif
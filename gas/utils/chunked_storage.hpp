@@ -0,0 +1,230 @@
+/// GAS::Utils::ChunkedStorage append-only container class.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_UTILS_CHUNKED_STORAGE_INCLUDED
+#define GAS_UTILS_CHUNKED_STORAGE_INCLUDED
+
+#include <gas/utils/memory_resource.hpp>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		/// Append-only container that allocates its elements in fixed-size chunks.
+		/// Element addresses are stable until the element is removed or the container is cleared.
+		/// \tparam Type
+		/// The element type.
+		/// \tparam ChunkSize
+		/// The number of elements per chunk.
+		/// \note
+		/// Unlike \c std::forward_list there is no per-element allocation nor link, and unlike \c std::deque the chunk size is fixed by the user.
+		/// \remark
+		/// The chunks and their table are allocated from a MemoryResource, which follows the container when it is moved or swapped.
+		template<class Type, std::size_t ChunkSize = 256>
+		class ChunkedStorage final
+		{
+
+			static_assert (ChunkSize > 0, "Chunk size must be positive");
+
+			/// Uninitialized storage for a single element.
+			using Slot = typename std::aligned_storage<sizeof (Type), alignof (Type)>::type;
+
+			/// Allocated chunks.
+			ResourceVector<Slot *> m_chunks;
+
+			/// Number of constructed elements.
+			std::size_t m_size {};
+
+			/// \param[in] index
+			/// The element index.
+			/// \return
+			/// The storage of the element at \p index.
+			Type *slot (std::size_t index) const;
+
+			/// Allocate a new chunk.
+			/// \exception std::bad_alloc
+			/// If the chunk cannot be allocated. The container is left unchanged.
+			void addChunk ();
+
+		public:
+
+			/// Forward iterator over the elements of a ChunkedStorage.
+			class ConstIterator final
+			{
+
+				friend class ChunkedStorage;
+
+				const ChunkedStorage *m_storage {};
+				std::size_t m_index {};
+
+				ConstIterator (const ChunkedStorage &storage, std::size_t index);
+
+			public:
+
+				using iterator_category = std::forward_iterator_tag;
+				using value_type = Type;
+				using difference_type = std::ptrdiff_t;
+				using pointer = const Type *;
+				using reference = const Type &;
+
+				/// Construct a singular iterator.
+				ConstIterator () = default;
+
+				ConstIterator &operator++();
+				ConstIterator operator++(int);
+
+				bool operator==(const ConstIterator &other) const;
+				bool operator!=(const ConstIterator &other) const;
+
+				const Type &operator*() const;
+				const Type *operator->() const;
+
+			};
+
+			/// Construct an empty container using newDeleteResource().
+			ChunkedStorage () = default;
+
+			/// Construct an empty container.
+			/// \param[in] resource
+			/// The resource to allocate the chunks from.
+			explicit ChunkedStorage (MemoryResource &resource);
+
+			/// Construct a container using newDeleteResource() by copying each element of \p copy.
+			/// \param[in] copy
+			/// The container to copy.
+			ChunkedStorage (const ChunkedStorage &copy);
+
+			/// Construct a container by moving the chunks of \p moved.
+			/// \param[in] moved
+			/// The container to move.
+			/// \remark
+			/// Element addresses are preserved. After calling this constructor \p moved will be empty and valid.
+			ChunkedStorage (ChunkedStorage &&moved) noexcept;
+
+			/// \see clear()
+			~ChunkedStorage ();
+
+			/// Clear the container and copy each element of \p copy, keeping the current resource.
+			/// \param[in] copy
+			/// The container to copy.
+			/// \return
+			/// This object.
+			ChunkedStorage &operator=(const ChunkedStorage &copy);
+
+			/// Clear the container and move the chunks of \p moved.
+			/// \param[in] moved
+			/// The container to move.
+			/// \return
+			/// This object.
+			/// \remark
+			/// Element addresses are preserved. After calling this method \p moved will be empty and valid.
+			ChunkedStorage &operator=(ChunkedStorage &&moved) noexcept;
+
+			/// Exchange the chunks of two containers in constant time.
+			/// \param[in] other
+			/// The container to swap with.
+			/// \remark
+			/// Element addresses are preserved.
+			void swap (ChunkedStorage &other) noexcept;
+
+			/// Append a copy of an element.
+			/// \param[in] value
+			/// The element to copy.
+			/// \return
+			/// The new element.
+			Type &pushBack (const Type &value);
+
+			/// Destroy the last element.
+			/// \pre
+			/// The container must not be empty.
+			void popBack ();
+
+			/// Allocate chunks in advance, so that the next elements can be appended without allocating.
+			/// \param[in] count
+			/// The number of elements that must fit in the allocated chunks.
+			/// \exception std::bad_alloc
+			/// If the chunks cannot be allocated. The chunks allocated so far are kept.
+			void reserve (std::size_t count);
+
+			/// Destroy all the elements.
+			/// \param[in] release
+			/// Whether to release the chunks too, or to keep them for the next elements.
+			void clear (bool release = true);
+
+			/// \return
+			/// The resource the chunks are allocated from.
+			MemoryResource &resource () const;
+
+			/// \return
+			/// The number of elements.
+			std::size_t size () const;
+
+			/// \return
+			/// \c true if there are no elements, \c false otherwise.
+			bool isEmpty () const;
+
+			/// \return
+			/// The number of elements that can be stored without allocating a new chunk.
+			std::size_t capacity () const;
+
+			/// \return
+			/// The number of bytes allocated for the chunks and their table.
+			std::size_t memoryUsage () const;
+
+			/// \return
+			/// The number of allocated chunks.
+			std::size_t chunksCount () const;
+
+			/// Get the storage of a chunk, so that element addresses can be related to their indices.
+			/// \param[in] index
+			/// The chunk index.
+			/// \pre
+			/// \p index must be less than chunksCount().
+			/// \return
+			/// The \c begin and \c end addresses of the storage of the \p ChunkSize elements of the chunk at \p index (not all of them may be constructed).
+			/// \remark
+			/// The element at index \c i is stored in the chunk at index <tt>i / ChunkSize</tt>, at offset <tt>i % ChunkSize</tt>.
+			std::pair<const void *, const void *> chunkRange (std::size_t index) const;
+
+			/// \param[in] index
+			/// The element index.
+			/// \pre
+			/// \p index must be less than size().
+			/// \return
+			/// The element at \p index.
+			Type &operator[](std::size_t index);
+
+			/// \param[in] index
+			/// The element index.
+			/// \pre
+			/// \p index must be less than size().
+			/// \return
+			/// The element at \p index.
+			const Type &operator[](std::size_t index) const;
+
+			/// \return
+			/// An iterator referring to the first element, in order of insertion.
+			ConstIterator begin () const;
+
+			/// \return
+			/// The past-the-end iterator.
+			ConstIterator end () const;
+
+		};
+
+	}
+
+}
+
+#include "chunked_storage.tpp"
+
+#endif
@@ -0,0 +1,264 @@
+#ifndef GAS_UTILS_CHUNKED_STORAGE_IMPL_INCLUDED
+#define GAS_UTILS_CHUNKED_STORAGE_IMPL_INCLUDED
+
+#ifndef GAS_UTILS_CHUNKED_STORAGE_INCLUDED
+#error 'gas/utils/chunked_storage.tpp' should not be directly included
+#endif
+
+#include "chunked_storage.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <utility>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		template<class Type, std::size_t ChunkSize>
+		ChunkedStorage<Type, ChunkSize>::ConstIterator::ConstIterator (const ChunkedStorage &_storage, std::size_t _index) : m_storage { &_storage }, m_index { _index }
+		{}
+
+		template<class Type, std::size_t ChunkSize>
+		typename ChunkedStorage<Type, ChunkSize>::ConstIterator &ChunkedStorage<Type, ChunkSize>::ConstIterator::operator++()
+		{
+			m_index++;
+			return *this;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		typename ChunkedStorage<Type, ChunkSize>::ConstIterator ChunkedStorage<Type, ChunkSize>::ConstIterator::operator++(int)
+		{
+			ConstIterator before { *this };
+			++ *this;
+			return before;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		bool ChunkedStorage<Type, ChunkSize>::ConstIterator::operator==(const ConstIterator &_other) const
+		{
+			return m_storage == _other.m_storage && m_index == _other.m_index;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		bool ChunkedStorage<Type, ChunkSize>::ConstIterator::operator!=(const ConstIterator &_other) const
+		{
+			return !(*this == _other);
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		const Type &ChunkedStorage<Type, ChunkSize>::ConstIterator::operator*() const
+		{
+			return (*m_storage)[m_index];
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		const Type *ChunkedStorage<Type, ChunkSize>::ConstIterator::operator->() const
+		{
+			return &**this;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		Type *ChunkedStorage<Type, ChunkSize>::slot (std::size_t _index) const
+		{
+			return reinterpret_cast<Type *>(&m_chunks[_index / ChunkSize][_index % ChunkSize]);
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		ChunkedStorage<Type, ChunkSize>::ChunkedStorage (MemoryResource &_resource) : m_chunks (ResourceAllocator<Slot *> { _resource })
+		{}
+
+		template<class Type, std::size_t ChunkSize>
+		ChunkedStorage<Type, ChunkSize>::ChunkedStorage (const ChunkedStorage &_copy)
+		{
+			*this = _copy;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		ChunkedStorage<Type, ChunkSize>::ChunkedStorage (ChunkedStorage &&_moved) noexcept : m_chunks { std::move (_moved.m_chunks) }, m_size { _moved.m_size }
+		{
+			_moved.m_chunks.clear ();
+			_moved.m_size = 0;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		ChunkedStorage<Type, ChunkSize>::~ChunkedStorage ()
+		{
+			clear ();
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		ChunkedStorage<Type, ChunkSize> &ChunkedStorage<Type, ChunkSize>::operator=(const ChunkedStorage &_copy)
+		{
+			if (this != &_copy)
+			{
+				clear ();
+				for (const Type &value : _copy)
+				{
+					pushBack (value);
+				}
+			}
+			return *this;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		ChunkedStorage<Type, ChunkSize> &ChunkedStorage<Type, ChunkSize>::operator=(ChunkedStorage &&_moved) noexcept
+		{
+			if (this != &_moved)
+			{
+				clear ();
+				m_chunks = std::move (_moved.m_chunks);
+				m_size = _moved.m_size;
+				_moved.m_chunks.clear ();
+				_moved.m_size = 0;
+			}
+			return *this;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		void ChunkedStorage<Type, ChunkSize>::swap (ChunkedStorage &_other) noexcept
+		{
+			m_chunks.swap (_other.m_chunks);
+			std::swap (m_size, _other.m_size);
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		void ChunkedStorage<Type, ChunkSize>::addChunk ()
+		{
+			// Grow the table first, so that the new chunk cannot leak
+			if (m_chunks.size () == m_chunks.capacity ())
+			{
+				m_chunks.reserve (std::max<std::size_t> (m_chunks.size () * 2, 8));
+			}
+			m_chunks.push_back (static_cast<Slot *>(resource ().allocate (sizeof (Slot) * ChunkSize, alignof (Slot))));
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		Type &ChunkedStorage<Type, ChunkSize>::pushBack (const Type &_value)
+		{
+			if (m_size == capacity ())
+			{
+				addChunk ();
+			}
+			Type *value { new (slot (m_size)) Type (_value) };
+			m_size++;
+			return *value;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		void ChunkedStorage<Type, ChunkSize>::popBack ()
+		{
+			assert (!isEmpty ());
+			m_size--;
+			slot (m_size)->~Type ();
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		void ChunkedStorage<Type, ChunkSize>::reserve (std::size_t _count)
+		{
+			if (_count > capacity ())
+			{
+				m_chunks.reserve ((_count + ChunkSize - 1) / ChunkSize);
+				while (_count > capacity ())
+				{
+					addChunk ();
+				}
+			}
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		void ChunkedStorage<Type, ChunkSize>::clear (bool _release)
+		{
+			while (!isEmpty ())
+			{
+				popBack ();
+			}
+			if (!_release)
+			{
+				return;
+			}
+			for (Slot *chunk : m_chunks)
+			{
+				resource ().deallocate (chunk, sizeof (Slot) * ChunkSize, alignof (Slot));
+			}
+			m_chunks.clear ();
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		MemoryResource &ChunkedStorage<Type, ChunkSize>::resource () const
+		{
+			return m_chunks.get_allocator ().resource ();
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		std::size_t ChunkedStorage<Type, ChunkSize>::size () const
+		{
+			return m_size;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		bool ChunkedStorage<Type, ChunkSize>::isEmpty () const
+		{
+			return m_size == 0;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		std::size_t ChunkedStorage<Type, ChunkSize>::capacity () const
+		{
+			return m_chunks.size () * ChunkSize;
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		std::size_t ChunkedStorage<Type, ChunkSize>::memoryUsage () const
+		{
+			return capacity () * sizeof (Slot) + m_chunks.capacity () * sizeof (Slot *);
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		std::size_t ChunkedStorage<Type, ChunkSize>::chunksCount () const
+		{
+			return m_chunks.size ();
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		std::pair<const void *, const void *> ChunkedStorage<Type, ChunkSize>::chunkRange (std::size_t _index) const
+		{
+			assert (_index < m_chunks.size ());
+			const Slot *chunk { m_chunks[_index] };
+			return { chunk, chunk + ChunkSize };
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		Type &ChunkedStorage<Type, ChunkSize>::operator[](std::size_t _index)
+		{
+			assert (_index < m_size);
+			return *slot (_index);
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		const Type &ChunkedStorage<Type, ChunkSize>::operator[](std::size_t _index) const
+		{
+			assert (_index < m_size);
+			return *slot (_index);
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		typename ChunkedStorage<Type, ChunkSize>::ConstIterator ChunkedStorage<Type, ChunkSize>::begin () const
+		{
+			return ConstIterator { *this, 0 };
+		}
+
+		template<class Type, std::size_t ChunkSize>
+		typename ChunkedStorage<Type, ChunkSize>::ConstIterator ChunkedStorage<Type, ChunkSize>::end () const
+		{
+			return ConstIterator { *this, m_size };
+		}
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,76 @@
+#include "epoch.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		EpochDomain::Guard::Guard (EpochDomain &_domain)
+		{
+			// Start from a per-thread slot to reduce contention
+			const std::size_t start { std::hash<std::thread::id> {} (std::this_thread::get_id ()) % _domain.m_slotsCount };
+			for (std::size_t i { start };; i = (i + 1) % _domain.m_slotsCount)
+			{
+				Slot &slot { _domain.m_slots[i] };
+				bool used { false };
+				if (!slot.used.load (std::memory_order_relaxed) && slot.used.compare_exchange_strong (used, true, std::memory_order_acquire))
+				{
+					m_slot = &slot;
+					break;
+				}
+				if ((i + 1) % _domain.m_slotsCount == start)
+				{
+					std::this_thread::yield ();
+				}
+			}
+			// Sequentially consistent so that either synchronize() sees this reader or this reader sees the objects published before it
+			m_slot->epoch.store (_domain.m_epoch.load (std::memory_order_seq_cst), std::memory_order_seq_cst);
+		}
+
+		EpochDomain::Guard::~Guard ()
+		{
+			m_slot->epoch.store (0, std::memory_order_release);
+			m_slot->used.store (false, std::memory_order_release);
+		}
+
+		EpochDomain::EpochDomain (std::size_t _maxReaders) : m_epoch { 1 }, m_slotsCount { _maxReaders }
+		{
+			if (_maxReaders == 0)
+			{
+				throw std::invalid_argument ("Readers count must be positive");
+			}
+			m_slots.reset (new Slot[_maxReaders]);
+			for (std::size_t i {}; i < _maxReaders; i++)
+			{
+				m_slots[i].used.store (false, std::memory_order_relaxed);
+				m_slots[i].epoch.store (0, std::memory_order_relaxed);
+			}
+		}
+
+		void EpochDomain::synchronize ()
+		{
+			const unsigned long long epoch { m_epoch.fetch_add (1, std::memory_order_seq_cst) };
+			for (std::size_t i {}; i < m_slotsCount; i++)
+			{
+				const std::atomic<unsigned long long> &slotEpoch { m_slots[i].epoch };
+				while (true)
+				{
+					// Also acquires, so that the accesses of a leaving reader happen before the caller reclaims
+					const unsigned long long readerEpoch { slotEpoch.load (std::memory_order_seq_cst) };
+					if (readerEpoch == 0 || readerEpoch > epoch)
+					{
+						break;
+					}
+					std::this_thread::yield ();
+				}
+			}
+		}
+
+	}
+
+}
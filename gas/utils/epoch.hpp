@@ -0,0 +1,87 @@
+/// GAS::Utils::EpochDomain epoch-based reclamation primitive.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_UTILS_EPOCH_INCLUDED
+#define GAS_UTILS_EPOCH_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		/// Epoch-based reclamation domain.
+		/// Readers mark the sections in which they access shared objects through a Guard, without locking nor writing shared cache lines
+		/// other than their own slot. Writers unlink an object, call synchronize() and then reuse or destroy it, since no reader can still access it.
+		/// \remark
+		/// All the methods can be called concurrently.
+		class EpochDomain final
+		{
+
+			/// Reader slot, padded to a cache line to avoid false sharing.
+			struct Slot
+			{
+				/// Epoch in which the reader entered, or \c 0 if no reader is inside.
+				std::atomic<unsigned long long> epoch;
+				/// Whether a guard owns the slot.
+				std::atomic<bool> used;
+				char padding[64 - sizeof (std::atomic<unsigned long long>) - sizeof (std::atomic<bool>)];
+			};
+
+			std::atomic<unsigned long long> m_epoch;
+			const std::size_t m_slotsCount;
+			std::unique_ptr<Slot[]> m_slots;
+
+		public:
+
+			/// Read-side critical section.
+			/// Shared objects loaded while the guard is alive are not reclaimed until the guard is destroyed.
+			class Guard final
+			{
+
+				Slot *m_slot;
+
+			public:
+
+				/// Enter a read-side critical section.
+				/// \param[in] domain
+				/// The domain.
+				/// \remark
+				/// If all the slots are in use, waits until one is released.
+				explicit Guard (EpochDomain &domain);
+
+				/// Leave the read-side critical section.
+				~Guard ();
+
+				Guard (const Guard &) = delete;
+				Guard &operator=(const Guard &) = delete;
+
+			};
+
+			/// Construct a domain.
+			/// \param[in] maxReaders
+			/// The maximum number of concurrent guards that can be alive without waiting.
+			/// \exception std::invalid_argument
+			/// If \p maxReaders is zero.
+			explicit EpochDomain (std::size_t maxReaders = 64);
+
+			EpochDomain (const EpochDomain &) = delete;
+			EpochDomain &operator=(const EpochDomain &) = delete;
+
+			/// Wait until every guard created before this call has been destroyed.
+			/// \remark
+			/// Guards created during this call do not delay it.
+			void synchronize ();
+
+		};
+
+	}
+
+}
+
+#endif
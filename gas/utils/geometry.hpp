@@ -63,6 +63,22 @@ namespace GAS
 		template<class Scalar>
 		Scalar evalLine (const Segment<Scalar> &line, Scalar x);
 
+		/// Compare the y-coordinates of two lines at a given x-coordinate without performing any division.
+		/// \tparam Scalar
+		/// The scalar type.
+		/// \param[in] a
+		/// Any segment that lies on the first line.
+		/// \param[in] b
+		/// Any segment that lies on the second line.
+		/// \param[in] x
+		/// The x-coordinate where to compare the lines.
+		/// \pre
+		/// \c a and \c b must not be degenerate or vertical.
+		/// \return
+		/// A positive value if \p a is above \p b at \p x, a negative value if it is below, zero if they meet.
+		template<class Scalar>
+		int compareLinesAtX (const Segment<Scalar> &a, const Segment<Scalar> &b, Scalar x);
+
 		/// \tparam Scalar
 		/// The scalar type.
 		/// \param[in] segment
@@ -127,6 +143,102 @@ namespace GAS
 		template<class Scalar>
 		bool isSegmentInsideBox (const Segment<Scalar> &segment, const Point<Scalar> &bottomLeft, const Point<Scalar> &topRight);
 
+		/// Get the point lying on a line at a given x-coordinate.
+		/// \tparam Out
+		/// The output point scalar type, used for the evaluation too.
+		/// \tparam Scalar
+		/// The input scalar type.
+		/// \param[in] line
+		/// Any segment that lies on the line to evaluate.
+		/// \param[in] x
+		/// The x-coordinate of the point.
+		/// \pre
+		/// \p line must not be degenerate or vertical.
+		/// \return
+		/// The point of the line at \p x.
+		template<class Out, class Scalar>
+		Point<Out> getPointOnLine (const Segment<Scalar> &line, const Scalar &x);
+
+		/// Get the centroid of the four vertices of a trapezoid.
+		/// \tparam Out
+		/// The output point scalar type, used for the evaluation too.
+		/// \tparam Scalar
+		/// The trapezoid scalar type.
+		/// \param[in] left
+		/// The point defining the left side of the trapezoid.
+		/// \param[in] right
+		/// The point defining the right side of the trapezoid.
+		/// \param[in] bottom
+		/// The bottom segment of the trapezoid.
+		/// \param[in] top
+		/// The top segment of the trapezoid.
+		/// \return
+		/// The average of the four vertices.
+		template<class Out, class Scalar>
+		Point<Out> getTrapezoidCentroid (const Point<Scalar> &left, const Point<Scalar> &right, const Segment<Scalar> &bottom, const Segment<Scalar> &top);
+
+		/// \tparam Out
+		/// The output scalar type, used for the evaluation too.
+		/// \tparam Scalar
+		/// The trapezoid scalar type.
+		/// \param[in] left
+		/// The point defining the left side of the trapezoid.
+		/// \param[in] right
+		/// The point defining the right side of the trapezoid.
+		/// \param[in] bottom
+		/// The bottom segment of the trapezoid.
+		/// \param[in] top
+		/// The top segment of the trapezoid.
+		/// \return
+		/// The area of the trapezoid.
+		template<class Out, class Scalar>
+		Out getTrapezoidArea (const Point<Scalar> &left, const Point<Scalar> &right, const Segment<Scalar> &bottom, const Segment<Scalar> &top);
+
+		/// \tparam In
+		/// The point scalar type, used for the evaluation too.
+		/// \tparam Scalar
+		/// The trapezoid scalar type.
+		/// \param[in] point
+		/// The point to test.
+		/// \param[in] left
+		/// The point defining the left side of the trapezoid.
+		/// \param[in] right
+		/// The point defining the right side of the trapezoid.
+		/// \param[in] bottom
+		/// The bottom segment of the trapezoid.
+		/// \param[in] top
+		/// The top segment of the trapezoid.
+		/// \return
+		/// \c true if \p point is strictly inside the trapezoid, \c false otherwise.
+		template<class In, class Scalar>
+		bool isPointInsideTrapezoid (const Point<In> &point, const Point<Scalar> &left, const Point<Scalar> &right, const Segment<Scalar> &bottom, const Segment<Scalar> &top);
+
+		/// \tparam Scalar
+		/// The trapezoid scalar type.
+		/// \param[in] left
+		/// The point defining the left side of the trapezoid.
+		/// \param[in] bottom
+		/// The bottom segment of the trapezoid.
+		/// \param[in] top
+		/// The top segment of the trapezoid.
+		/// \return
+		/// \c true if \p bottom and \p top start at \p left, so that the trapezoid has no left side, \c false otherwise.
+		template<class Scalar>
+		bool isTrapezoidJointLeft (const Point<Scalar> &left, const Segment<Scalar> &bottom, const Segment<Scalar> &top);
+
+		/// \tparam Scalar
+		/// The trapezoid scalar type.
+		/// \param[in] right
+		/// The point defining the right side of the trapezoid.
+		/// \param[in] bottom
+		/// The bottom segment of the trapezoid.
+		/// \param[in] top
+		/// The top segment of the trapezoid.
+		/// \return
+		/// \c true if \p bottom and \p top end at \p right, so that the trapezoid has no right side, \c false otherwise.
+		template<class Scalar>
+		bool isTrapezoidJointRight (const Point<Scalar> &right, const Segment<Scalar> &bottom, const Segment<Scalar> &top);
+
 		/// Convenience function for converting the scalar type of a point.
 		///	\tparam In
 		/// The input point scalar type.
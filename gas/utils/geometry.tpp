@@ -38,6 +38,18 @@ namespace GAS
 			return (b.y () - a.y ()) * (_x - a.x ()) / (b.x () - a.x ()) + a.y ();
 		}
 
+		template<class Scalar>
+		int compareLinesAtX (const Segment<Scalar> &_a, const Segment<Scalar> &_b, Scalar _x)
+		{
+			assert (!isSegmentVertical (_a) && !isSegmentVertical (_b));
+			const Point<Scalar> &a1 { _a.p1 () }, &a2 { _a.p2 () }, &b1 { _b.p1 () }, &b2 { _b.p2 () };
+			const Scalar aDx { a2.x () - a1.x () }, bDx { b2.x () - b1.x () };
+			// (evalLine (a, x) - evalLine (b, x)) * aDx * bDx
+			const Scalar diff { (a1.y () - b1.y ()) * aDx * bDx + (a2.y () - a1.y ()) * (_x - a1.x ()) * bDx - (b2.y () - b1.y ()) * (_x - b1.x ()) * aDx };
+			const int sign { diff > 0 ? 1 : diff < 0 ? -1 : 0 };
+			return (aDx > 0) == (bDx > 0) ? sign : -sign;
+		}
+
 		template<class Scalar>
 		bool areSegmentPointsHorizzontallySorted (const Segment<Scalar> &_segment)
 		{
@@ -78,6 +90,49 @@ namespace GAS
 				&& isPointInsideBox (_segment.p2 (), _bottomLeft, _topRight);
 		}
 
+		template<class Out, class Scalar>
+		Point<Out> getPointOnLine (const Segment<Scalar> &_line, const Scalar &_x)
+		{
+			const Out x { static_cast<Out>(_x) };
+			return { x, evalLine (cast<Out> (_line), x) };
+		}
+
+		template<class Out, class Scalar>
+		Point<Out> getTrapezoidCentroid (const Point<Scalar> &_left, const Point<Scalar> &_right, const Segment<Scalar> &_bottom, const Segment<Scalar> &_top)
+		{
+			return (getPointOnLine<Out> (_bottom, _left.x ()) + getPointOnLine<Out> (_bottom, _right.x ())
+				+ getPointOnLine<Out> (_top, _left.x ()) + getPointOnLine<Out> (_top, _right.x ())) / Out { 4 };
+		}
+
+		template<class Out, class Scalar>
+		Out getTrapezoidArea (const Point<Scalar> &_left, const Point<Scalar> &_right, const Segment<Scalar> &_bottom, const Segment<Scalar> &_top)
+		{
+			const Out leftHeight { getPointOnLine<Out> (_top, _left.x ()).y () - getPointOnLine<Out> (_bottom, _left.x ()).y () };
+			const Out rightHeight { getPointOnLine<Out> (_top, _right.x ()).y () - getPointOnLine<Out> (_bottom, _right.x ()).y () };
+			return static_cast<Out>(_right.x () - _left.x ()) * (leftHeight + rightHeight) / Out { 2 };
+		}
+
+		template<class In, class Scalar>
+		bool isPointInsideTrapezoid (const Point<In> &_point, const Point<Scalar> &_left, const Point<Scalar> &_right, const Segment<Scalar> &_bottom, const Segment<Scalar> &_top)
+		{
+			return _point.x () > static_cast<In>(_left.x ())
+				&& _point.x () < static_cast<In>(_right.x ())
+				&& getPointSideWithSegment (cast<In> (_top), _point) == ESide::Right
+				&& getPointSideWithSegment (cast<In> (_bottom), _point) == ESide::Left;
+		}
+
+		template<class Scalar>
+		bool isTrapezoidJointLeft (const Point<Scalar> &_left, const Segment<Scalar> &_bottom, const Segment<Scalar> &_top)
+		{
+			return _bottom.p1 () == _top.p1 () && _bottom.p1 () == _left;
+		}
+
+		template<class Scalar>
+		bool isTrapezoidJointRight (const Point<Scalar> &_right, const Segment<Scalar> &_bottom, const Segment<Scalar> &_top)
+		{
+			return _bottom.p2 () == _top.p2 () && _bottom.p2 () == _right;
+		}
+
 		template<class Out, class In>
 		const Point<Out> cast (const Point<In> &_in)
 		{
@@ -0,0 +1,220 @@
+#include "memory_resource.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <new>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		namespace
+		{
+
+			class NewDeleteResource final : public MemoryResource
+			{
+
+			protected:
+
+				void *doAllocate (std::size_t _bytes, std::size_t _alignment) override
+				{
+					if (_alignment > alignof (std::max_align_t))
+					{
+						throw std::bad_alloc {};
+					}
+					return ::operator new (_bytes);
+				}
+
+				void doDeallocate (void *_pointer, std::size_t, std::size_t) override
+				{
+					::operator delete (_pointer);
+				}
+
+			};
+
+			class NullResource final : public MemoryResource
+			{
+
+			protected:
+
+				void *doAllocate (std::size_t, std::size_t) override
+				{
+					throw std::bad_alloc {};
+				}
+
+				void doDeallocate (void *, std::size_t, std::size_t) override
+				{
+					assert (false);
+				}
+
+			};
+
+		}
+
+		bool MemoryResource::doIsEqual (const MemoryResource &_other) const
+		{
+			return this == &_other;
+		}
+
+		void *MemoryResource::allocate (std::size_t _bytes, std::size_t _alignment)
+		{
+			return doAllocate (_bytes, _alignment);
+		}
+
+		void MemoryResource::deallocate (void *_pointer, std::size_t _bytes, std::size_t _alignment)
+		{
+			doDeallocate (_pointer, _bytes, _alignment);
+		}
+
+		bool MemoryResource::isEqual (const MemoryResource &_other) const
+		{
+			return doIsEqual (_other);
+		}
+
+		MemoryResource &newDeleteResource ()
+		{
+			static NewDeleteResource resource;
+			return resource;
+		}
+
+		MemoryResource &nullResource ()
+		{
+			static NullResource resource;
+			return resource;
+		}
+
+		void *MonotonicBufferResource::doAllocate (std::size_t _bytes, std::size_t _alignment)
+		{
+			void *block { std::align (_alignment, _bytes, m_current, m_available) };
+			if (!block)
+			{
+				// The header keeps the data of the new buffer aligned to max_align_t
+				const std::size_t headerSize { (sizeof (Buffer) + alignof (std::max_align_t) - 1) / alignof (std::max_align_t) * alignof (std::max_align_t) };
+				constexpr std::size_t maxSize { std::numeric_limits<std::size_t>::max () };
+				// The sizes must not wrap around, or a buffer too small for the block would be requested
+				if (_alignment > maxSize - headerSize || _bytes > maxSize - headerSize - _alignment || m_nextSize > maxSize - headerSize)
+				{
+					throw std::bad_alloc {};
+				}
+				const std::size_t size { std::max (m_nextSize, _bytes + _alignment) };
+				Buffer *const buffer { static_cast<Buffer *>(m_upstream.allocate (headerSize + size)) };
+				buffer->previous = m_buffers;
+				buffer->size = headerSize + size;
+				m_buffers = buffer;
+				m_current = reinterpret_cast<char *>(buffer) + headerSize;
+				m_available = size;
+				m_nextSize = size <= (maxSize - headerSize) / 2 ? size * 2 : maxSize - headerSize;
+				block = std::align (_alignment, _bytes, m_current, m_available);
+				assert (block);
+			}
+			m_current = static_cast<char *>(m_current) + _bytes;
+			m_available -= _bytes;
+			return block;
+		}
+
+		void MonotonicBufferResource::doDeallocate (void *, std::size_t, std::size_t)
+		{}
+
+		MonotonicBufferResource::MonotonicBufferResource (std::size_t _initialSize, MemoryResource &_upstream)
+			: m_upstream { _upstream }, m_initialBuffer {}, m_initialSize {}, m_current {}, m_available {}, m_nextSize { std::max<std::size_t> (_initialSize, 1) }
+		{}
+
+		MonotonicBufferResource::MonotonicBufferResource (void *_buffer, std::size_t _size, MemoryResource &_upstream)
+			: m_upstream { _upstream }, m_initialBuffer { _buffer }, m_initialSize { _size }, m_current { _buffer }, m_available { _size }, m_nextSize { std::max<std::size_t> (_size, 1) }
+		{}
+
+		MonotonicBufferResource::~MonotonicBufferResource ()
+		{
+			release ();
+		}
+
+		void MonotonicBufferResource::release ()
+		{
+			while (m_buffers)
+			{
+				Buffer *const previous { m_buffers->previous };
+				m_upstream.deallocate (m_buffers, m_buffers->size);
+				m_buffers = previous;
+			}
+			m_current = m_initialBuffer;
+			m_available = m_initialSize;
+		}
+
+		MemoryResource &MonotonicBufferResource::upstream () const
+		{
+			return m_upstream;
+		}
+
+		void *TrackingResource::doAllocate (std::size_t _bytes, std::size_t _alignment)
+		{
+			{
+				std::lock_guard<std::mutex> lock { m_mutex };
+				if (_bytes > m_quota - m_bytesInUse)
+				{
+					throw std::bad_alloc {};
+				}
+				// Reserve before allocating, so that concurrent allocations cannot exceed the quota
+				m_bytesInUse += _bytes;
+			}
+			void *pointer;
+			try
+			{
+				pointer = m_upstream.allocate (_bytes, _alignment);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock { m_mutex };
+				m_bytesInUse -= _bytes;
+				throw;
+			}
+			std::lock_guard<std::mutex> lock { m_mutex };
+			m_peakBytes = std::max (m_peakBytes, m_bytesInUse);
+			m_allocationsCount++;
+			return pointer;
+		}
+
+		void TrackingResource::doDeallocate (void *_pointer, std::size_t _bytes, std::size_t _alignment)
+		{
+			m_upstream.deallocate (_pointer, _bytes, _alignment);
+			std::lock_guard<std::mutex> lock { m_mutex };
+			assert (_bytes <= m_bytesInUse);
+			m_bytesInUse -= _bytes;
+		}
+
+		TrackingResource::TrackingResource (MemoryResource &_upstream, std::size_t _quota) : m_upstream { _upstream }, m_quota { _quota }
+		{}
+
+		std::size_t TrackingResource::quota () const
+		{
+			return m_quota;
+		}
+
+		std::size_t TrackingResource::bytesInUse () const
+		{
+			std::lock_guard<std::mutex> lock { m_mutex };
+			return m_bytesInUse;
+		}
+
+		std::size_t TrackingResource::peakBytes () const
+		{
+			std::lock_guard<std::mutex> lock { m_mutex };
+			return m_peakBytes;
+		}
+
+		std::size_t TrackingResource::allocationsCount () const
+		{
+			std::lock_guard<std::mutex> lock { m_mutex };
+			return m_allocationsCount;
+		}
+
+		MemoryResource &TrackingResource::upstream () const
+		{
+			return m_upstream;
+		}
+
+	}
+
+}
@@ -0,0 +1,319 @@
+/// GAS::Utils::MemoryResource polymorphic allocation interface and its implementations.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_UTILS_MEMORY_RESOURCE_INCLUDED
+#define GAS_UTILS_MEMORY_RESOURCE_INCLUDED
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		/// Source of raw memory, since \c std::pmr::memory_resource is not available in C++11.
+		/// The interface mirrors it, so that porting to C++17 only requires an adapter.
+		/// \remark
+		/// A resource must outlive all the objects allocating from it.
+		class MemoryResource
+		{
+
+		protected:
+
+			/// \copydoc allocate()
+			virtual void *doAllocate (std::size_t bytes, std::size_t alignment) = 0;
+
+			/// \copydoc deallocate()
+			virtual void doDeallocate (void *pointer, std::size_t bytes, std::size_t alignment) = 0;
+
+			/// \copydoc isEqual()
+			virtual bool doIsEqual (const MemoryResource &other) const;
+
+		public:
+
+			MemoryResource () = default;
+			virtual ~MemoryResource () = default;
+
+			MemoryResource (const MemoryResource &) = delete;
+			MemoryResource &operator=(const MemoryResource &) = delete;
+
+			/// Allocate a block of memory.
+			/// \param[in] bytes
+			/// The size of the block.
+			/// \param[in] alignment
+			/// The alignment of the block, a power of two.
+			/// \return
+			/// The block.
+			/// \exception std::bad_alloc
+			/// If the block cannot be allocated.
+			void *allocate (std::size_t bytes, std::size_t alignment = alignof (std::max_align_t));
+
+			/// Release a block of memory.
+			/// \param[in] pointer
+			/// The block, returned by allocate() with the same \p bytes and \p alignment.
+			/// \param[in] bytes
+			/// The size of the block.
+			/// \param[in] alignment
+			/// The alignment of the block.
+			void deallocate (void *pointer, std::size_t bytes, std::size_t alignment = alignof (std::max_align_t));
+
+			/// \param[in] other
+			/// The other resource.
+			/// \return
+			/// \c true if the memory allocated by this resource can be released by \p other and vice versa, \c false otherwise.
+			bool isEqual (const MemoryResource &other) const;
+
+		};
+
+		/// \return
+		/// The resource using the global \c operator \c new and \c operator \c delete. Used by default.
+		/// \remark
+		/// Alignments greater than <tt>alignof (std::max_align_t)</tt> are not supported.
+		MemoryResource &newDeleteResource ();
+
+		/// \return
+		/// The resource that always fails, to be used as the upstream of resources that must never grow.
+		MemoryResource &nullResource ();
+
+		/// Resource that carves the blocks out of a buffer and releases them only when destroyed, like \c std::pmr::monotonic_buffer_resource.
+		/// When the buffer is exhausted, geometrically growing buffers are requested to the upstream resource.
+		/// \remark
+		/// Deallocation does nothing, so it is best suited for structures that only grow and are destroyed at once.
+		/// \remark
+		/// Not thread-safe.
+		class MonotonicBufferResource final : public MemoryResource
+		{
+
+			/// Header of a buffer requested to the upstream resource.
+			struct Buffer
+			{
+				Buffer *previous;
+				std::size_t size;
+			};
+
+			MemoryResource &m_upstream;
+			void *const m_initialBuffer;
+			const std::size_t m_initialSize;
+			Buffer *m_buffers {};
+			void *m_current;
+			std::size_t m_available;
+			std::size_t m_nextSize;
+
+		protected:
+
+			void *doAllocate (std::size_t bytes, std::size_t alignment) override;
+
+			void doDeallocate (void *pointer, std::size_t bytes, std::size_t alignment) override;
+
+		public:
+
+			/// Construct a resource without an initial buffer.
+			/// \param[in] initialSize
+			/// The size of the first buffer requested to \p upstream.
+			/// \param[in] upstream
+			/// The resource providing the buffers.
+			explicit MonotonicBufferResource (std::size_t initialSize = 4096, MemoryResource &upstream = newDeleteResource ());
+
+			/// Construct a resource that starts allocating from a user buffer.
+			/// \param[in] buffer
+			/// The initial buffer, which must outlive the resource.
+			/// \param[in] size
+			/// The size of \p buffer.
+			/// \param[in] upstream
+			/// The resource providing the buffers once \p buffer is exhausted. Use nullResource() to never grow.
+			MonotonicBufferResource (void *buffer, std::size_t size, MemoryResource &upstream = newDeleteResource ());
+
+			/// \see release()
+			~MonotonicBufferResource () override;
+
+			/// Release all the buffers requested to the upstream resource and start again from the initial buffer.
+			/// \remark
+			/// All the blocks allocated through this resource will be invalidated.
+			void release ();
+
+			/// \return
+			/// The upstream resource.
+			MemoryResource &upstream () const;
+
+		};
+
+		/// Resource that forwards to an upstream resource, measuring the memory in use and enforcing a quota on it.
+		/// \remark
+		/// Thread-safe if the upstream resource is.
+		class TrackingResource final : public MemoryResource
+		{
+
+			MemoryResource &m_upstream;
+			const std::size_t m_quota;
+			mutable std::mutex m_mutex;
+			std::size_t m_bytesInUse {}, m_peakBytes {}, m_allocationsCount {};
+
+		protected:
+
+			/// \copydoc MemoryResource::allocate()
+			/// \exception std::bad_alloc
+			/// If the block would exceed the quota or cannot be allocated by the upstream resource.
+			void *doAllocate (std::size_t bytes, std::size_t alignment) override;
+
+			void doDeallocate (void *pointer, std::size_t bytes, std::size_t alignment) override;
+
+		public:
+
+			/// \param[in] upstream
+			/// The resource to forward to.
+			/// \param[in] quota
+			/// The maximum number of bytes in use at once.
+			explicit TrackingResource (MemoryResource &upstream = newDeleteResource (), std::size_t quota = std::numeric_limits<std::size_t>::max ());
+
+			/// \return
+			/// The maximum number of bytes in use at once.
+			std::size_t quota () const;
+
+			/// \return
+			/// The number of bytes allocated and not yet deallocated.
+			std::size_t bytesInUse () const;
+
+			/// \return
+			/// The highest value of bytesInUse() so far.
+			std::size_t peakBytes () const;
+
+			/// \return
+			/// The number of successful allocations so far.
+			std::size_t allocationsCount () const;
+
+			/// \return
+			/// The upstream resource.
+			MemoryResource &upstream () const;
+
+		};
+
+		/// Standard allocator drawing from a MemoryResource, like \c std::pmr::polymorphic_allocator.
+		/// \tparam Type
+		/// The value type.
+		/// \remark
+		/// Unlike \c std::pmr::polymorphic_allocator, which never propagates, the resource follows the container when it is moved or swapped,
+		/// so that moving or swapping two containers never copies their elements. Copies of a container use newDeleteResource().
+		template<class Type>
+		class ResourceAllocator
+		{
+
+			template<class Other>
+			friend class ResourceAllocator;
+
+			MemoryResource *m_resource;
+
+		public:
+
+			using value_type = Type;
+			using propagate_on_container_move_assignment = std::true_type;
+			using propagate_on_container_swap = std::true_type;
+
+			/// Construct an allocator using newDeleteResource().
+			ResourceAllocator ();
+
+			/// \param[in] resource
+			/// The resource to draw from.
+			explicit ResourceAllocator (MemoryResource &resource);
+
+			/// \param[in] other
+			/// The allocator whose resource to draw from.
+			template<class Other>
+			ResourceAllocator (const ResourceAllocator<Other> &other);
+
+			/// \param[in] count
+			/// The number of elements.
+			/// \return
+			/// The uninitialized storage for \p count elements.
+			/// \exception std::bad_alloc
+			/// If the storage cannot be allocated.
+			Type *allocate (std::size_t count);
+
+			/// \param[in] pointer
+			/// The storage returned by allocate().
+			/// \param[in] count
+			/// The number of elements.
+			void deallocate (Type *pointer, std::size_t count);
+
+			/// \return
+			/// An allocator using newDeleteResource().
+			ResourceAllocator select_on_container_copy_construction () const;
+
+			/// \return
+			/// The resource.
+			MemoryResource &resource () const;
+
+			template<class Other>
+			bool operator==(const ResourceAllocator<Other> &other) const;
+
+			template<class Other>
+			bool operator!=(const ResourceAllocator<Other> &other) const;
+
+		};
+
+		/// Vector drawing from a MemoryResource.
+		template<class Type>
+		using ResourceVector = std::vector<Type, ResourceAllocator<Type>>;
+
+		/// Deleter for objects allocated through allocateUnique().
+		/// \tparam Type
+		/// The object type.
+		template<class Type>
+		class ResourceDeleter final
+		{
+
+			MemoryResource *m_resource;
+
+		public:
+
+			/// Construct a deleter using newDeleteResource().
+			ResourceDeleter ();
+
+			/// \param[in] resource
+			/// The resource the objects have been allocated from.
+			explicit ResourceDeleter (MemoryResource &resource);
+
+			/// Destroy and deallocate an object.
+			/// \param[in] pointer
+			/// The object.
+			void operator() (Type *pointer) const;
+
+			/// \return
+			/// The resource.
+			MemoryResource &resource () const;
+
+		};
+
+		/// Unique pointer to an object allocated from a MemoryResource.
+		template<class Type>
+		using ResourceUniquePtr = std::unique_ptr<Type, ResourceDeleter<Type>>;
+
+		/// Allocate and construct an object from a MemoryResource.
+		/// \tparam Type
+		/// The object type.
+		/// \tparam Arguments
+		/// The constructor argument types.
+		/// \param[in] resource
+		/// The resource to allocate from.
+		/// \param[in] arguments
+		/// The constructor arguments.
+		/// \return
+		/// The owning pointer.
+		/// \exception std::bad_alloc
+		/// If the object cannot be allocated.
+		template<class Type, class ... Arguments>
+		ResourceUniquePtr<Type> allocateUnique (MemoryResource &resource, Arguments &&... arguments);
+
+	}
+
+}
+
+#include "memory_resource.tpp"
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef GAS_UTILS_MEMORY_RESOURCE_IMPL_INCLUDED
+#define GAS_UTILS_MEMORY_RESOURCE_IMPL_INCLUDED
+
+#ifndef GAS_UTILS_MEMORY_RESOURCE_INCLUDED
+#error 'gas/utils/memory_resource.tpp' should not be directly included
+#endif
+
+#include "memory_resource.hpp"
+
+#include <new>
+#include <utility>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		template<class Type>
+		ResourceAllocator<Type>::ResourceAllocator () : m_resource { &newDeleteResource () }
+		{}
+
+		template<class Type>
+		ResourceAllocator<Type>::ResourceAllocator (MemoryResource &_resource) : m_resource { &_resource }
+		{}
+
+		template<class Type>
+		template<class Other>
+		ResourceAllocator<Type>::ResourceAllocator (const ResourceAllocator<Other> &_other) : m_resource { _other.m_resource }
+		{}
+
+		template<class Type>
+		Type *ResourceAllocator<Type>::allocate (std::size_t _count)
+		{
+			if (_count > std::numeric_limits<std::size_t>::max () / sizeof (Type))
+			{
+				throw std::bad_alloc {};
+			}
+			return static_cast<Type *>(m_resource->allocate (_count * sizeof (Type), alignof (Type)));
+		}
+
+		template<class Type>
+		void ResourceAllocator<Type>::deallocate (Type *_pointer, std::size_t _count)
+		{
+			m_resource->deallocate (_pointer, _count * sizeof (Type), alignof (Type));
+		}
+
+		template<class Type>
+		ResourceAllocator<Type> ResourceAllocator<Type>::select_on_container_copy_construction () const
+		{
+			return ResourceAllocator {};
+		}
+
+		template<class Type>
+		MemoryResource &ResourceAllocator<Type>::resource () const
+		{
+			return *m_resource;
+		}
+
+		template<class Type>
+		template<class Other>
+		bool ResourceAllocator<Type>::operator==(const ResourceAllocator<Other> &_other) const
+		{
+			return m_resource->isEqual (*_other.m_resource);
+		}
+
+		template<class Type>
+		template<class Other>
+		bool ResourceAllocator<Type>::operator!=(const ResourceAllocator<Other> &_other) const
+		{
+			return !(*this == _other);
+		}
+
+		template<class Type>
+		ResourceDeleter<Type>::ResourceDeleter () : m_resource { &newDeleteResource () }
+		{}
+
+		template<class Type>
+		ResourceDeleter<Type>::ResourceDeleter (MemoryResource &_resource) : m_resource { &_resource }
+		{}
+
+		template<class Type>
+		void ResourceDeleter<Type>::operator() (Type *_pointer) const
+		{
+			_pointer->~Type ();
+			m_resource->deallocate (_pointer, sizeof (Type), alignof (Type));
+		}
+
+		template<class Type>
+		MemoryResource &ResourceDeleter<Type>::resource () const
+		{
+			return *m_resource;
+		}
+
+		template<class Type, class ... Arguments>
+		ResourceUniquePtr<Type> allocateUnique (MemoryResource &_resource, Arguments &&... _arguments)
+		{
+			void *const storage { _resource.allocate (sizeof (Type), alignof (Type)) };
+			try
+			{
+				return ResourceUniquePtr<Type> { new (storage) Type (std::forward<Arguments> (_arguments)...), ResourceDeleter<Type> { _resource } };
+			}
+			catch (...)
+			{
+				_resource.deallocate (storage, sizeof (Type), alignof (Type));
+				throw;
+			}
+		}
+
+	}
+
+}
+
+#endif
@@ -9,7 +9,7 @@ namespace GAS
 	namespace Utils
 	{
 
-		int Serial::s_serial {};
+		std::atomic<int> Serial::s_serial { 0 };
 
 		char Serial::encodeDigit (int _digit)
 		{
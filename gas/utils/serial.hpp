@@ -5,6 +5,7 @@
 #ifndef GAS_UTILS_SERIAL_INCLUDED
 #define GAS_UTILS_SERIAL_INCLUDED
 
+#include <atomic>
 #include <string>
 
 namespace GAS
@@ -17,13 +18,15 @@ namespace GAS
 		/// \note
 		/// I could have used \c boost::uuids but it seems that external libraries are not allowed by the project specifications.
 		/// Anyway, this is more plug and play since it already intercepts copy constructions and copy assignments and it produces simpler human-readable serials.
+		/// \remark
+		/// Serials can be safely created on multiple threads. Each creation still writes a shared counter, so it is meant for debugging only.
 		class Serial final
 		{
 
 			/// Auto incrementing global counter.
-			static int s_serial;
+			static std::atomic<int> s_serial;
 
-			int m_serial { s_serial++ };
+			int m_serial { s_serial.fetch_add (1, std::memory_order_relaxed) };
 
 			/// Encode a base 36 digit into an easy-to-read alphanumeric character.
 			/// \param[in] digit
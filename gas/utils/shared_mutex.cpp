@@ -0,0 +1,59 @@
+#include "shared_mutex.hpp"
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		void SharedMutex::lock ()
+		{
+			std::unique_lock<std::mutex> lock { m_mutex };
+			m_condition.wait (lock, [this] () { return !m_writer; });
+			// Stop new shared owners, then wait for the current ones
+			m_writer = true;
+			m_condition.wait (lock, [this] () { return m_readersCount == 0; });
+		}
+
+		void SharedMutex::unlock ()
+		{
+			{
+				std::lock_guard<std::mutex> lock { m_mutex };
+				m_writer = false;
+			}
+			m_condition.notify_all ();
+		}
+
+		void SharedMutex::lock_shared ()
+		{
+			std::unique_lock<std::mutex> lock { m_mutex };
+			m_condition.wait (lock, [this] () { return !m_writer; });
+			m_readersCount++;
+		}
+
+		void SharedMutex::unlock_shared ()
+		{
+			bool last;
+			{
+				std::lock_guard<std::mutex> lock { m_mutex };
+				last = --m_readersCount == 0;
+			}
+			if (last)
+			{
+				m_condition.notify_all ();
+			}
+		}
+
+		SharedLock::SharedLock (SharedMutex &_mutex) : m_mutex { _mutex }
+		{
+			m_mutex.lock_shared ();
+		}
+
+		SharedLock::~SharedLock ()
+		{
+			m_mutex.unlock_shared ();
+		}
+
+	}
+
+}
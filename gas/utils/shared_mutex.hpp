@@ -0,0 +1,76 @@
+/// GAS::Utils::SharedMutex readers-writer lock.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_UTILS_SHARED_MUTEX_INCLUDED
+#define GAS_UTILS_SHARED_MUTEX_INCLUDED
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		/// Readers-writer lock, since \c std::shared_mutex is not available in C++11.
+		/// Exclusive locking has the same interface of \c std::mutex, so \c std::lock_guard and \c std::unique_lock can be used.
+		/// \remark
+		/// Writers are preferred: once a writer is waiting, new shared owners wait until it unlocks.
+		class SharedMutex final
+		{
+
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+			std::size_t m_readersCount {};
+			bool m_writer {};
+
+		public:
+
+			SharedMutex () = default;
+
+			SharedMutex (const SharedMutex &) = delete;
+			SharedMutex &operator=(const SharedMutex &) = delete;
+
+			/// Lock exclusively, waiting for the other owners.
+			void lock ();
+
+			/// Unlock an exclusive ownership.
+			void unlock ();
+
+			/// Lock shared, waiting for the exclusive owner and the waiting writers.
+			void lock_shared ();
+
+			/// Unlock a shared ownership.
+			void unlock_shared ();
+
+		};
+
+		/// Scoped shared ownership of a SharedMutex.
+		class SharedLock final
+		{
+
+			SharedMutex &m_mutex;
+
+		public:
+
+			/// Lock \p mutex shared.
+			/// \param[in] mutex
+			/// The mutex.
+			explicit SharedLock (SharedMutex &mutex);
+
+			/// Unlock the mutex.
+			~SharedLock ();
+
+			SharedLock (const SharedLock &) = delete;
+			SharedLock &operator=(const SharedLock &) = delete;
+
+		};
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,207 @@
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <utility>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		thread_local const ThreadPool *ThreadPool::s_currentPool {};
+		thread_local std::size_t ThreadPool::s_currentQueue {};
+
+		void ThreadPool::work (std::size_t _queue)
+		{
+			s_currentPool = this;
+			s_currentQueue = _queue;
+			while (true)
+			{
+				if (tryRunTask ())
+				{
+					continue;
+				}
+				std::unique_lock<std::mutex> lock { m_mutex };
+				m_condition.wait (lock, [this] () { return m_stopping || m_queuedCount.load () > 0; });
+				if (m_stopping && m_queuedCount.load () == 0)
+				{
+					return;
+				}
+			}
+		}
+
+		void ThreadPool::push (Task _task)
+		{
+			const std::size_t queue { isWorkerThread () ? s_currentQueue : m_nextQueue.fetch_add (1, std::memory_order_relaxed) % m_queues.size () };
+			{
+				// Counted before the task becomes visible, so that a thief cannot decrement the count first and make it wrap,
+				// and while locked, so that a worker going to sleep cannot miss it
+				std::lock_guard<std::mutex> lock { m_mutex };
+				m_queuedCount++;
+			}
+			try
+			{
+				std::lock_guard<std::mutex> lock { m_queues[queue]->mutex };
+				m_queues[queue]->tasks.push_back (std::move (_task));
+			}
+			catch (...)
+			{
+				m_queuedCount--;
+				throw;
+			}
+			m_condition.notify_one ();
+		}
+
+		bool ThreadPool::tryPop (std::size_t _queue, bool _newest, Task &_task)
+		{
+			Queue &queue { *m_queues[_queue] };
+			std::lock_guard<std::mutex> lock { queue.mutex };
+			if (queue.tasks.empty ())
+			{
+				return false;
+			}
+			if (_newest)
+			{
+				_task = std::move (queue.tasks.back ());
+				queue.tasks.pop_back ();
+			}
+			else
+			{
+				_task = std::move (queue.tasks.front ());
+				queue.tasks.pop_front ();
+			}
+			m_queuedCount--;
+			return true;
+		}
+
+		bool ThreadPool::tryRunTask ()
+		{
+			const bool worker { isWorkerThread () };
+			const std::size_t start { worker ? s_currentQueue : 0 };
+			Task task;
+			bool found { worker && tryPop (start, true, task) };
+			// Steal the oldest task of the other queues
+			for (std::size_t i { 1 }; !found && i <= m_queues.size (); i++)
+			{
+				found = tryPop ((start + i) % m_queues.size (), false, task);
+			}
+			if (found)
+			{
+				task ();
+			}
+			return found;
+		}
+
+		bool ThreadPool::isWorkerThread () const
+		{
+			return s_currentPool == this;
+		}
+
+		ThreadPool::ThreadPool (unsigned int _threadCount) : m_queuedCount { 0 }, m_nextQueue { 0 }
+		{
+			if (_threadCount == 0)
+			{
+				_threadCount = std::thread::hardware_concurrency ();
+				if (_threadCount == 0)
+				{
+					_threadCount = 1;
+				}
+			}
+			m_queues.reserve (_threadCount);
+			for (unsigned int i {}; i < _threadCount; i++)
+			{
+				m_queues.emplace_back (new Queue);
+			}
+			m_workers.reserve (_threadCount);
+			for (unsigned int i {}; i < _threadCount; i++)
+			{
+				m_workers.emplace_back (&ThreadPool::work, this, static_cast<std::size_t>(i));
+			}
+		}
+
+		ThreadPool::~ThreadPool ()
+		{
+			{
+				std::lock_guard<std::mutex> lock { m_mutex };
+				m_stopping = true;
+			}
+			m_condition.notify_all ();
+			for (std::thread &worker : m_workers)
+			{
+				worker.join ();
+			}
+		}
+
+		unsigned int ThreadPool::threadCount () const
+		{
+			return static_cast<unsigned int>(m_workers.size ());
+		}
+
+		void TaskGroup::finish (std::exception_ptr _error)
+		{
+			// Notify while locked, since the group may be destroyed as soon as the waiter wakes up
+			std::lock_guard<std::mutex> lock { m_mutex };
+			if (_error && !m_error)
+			{
+				m_error = _error;
+			}
+			if (--m_pendingCount == 0)
+			{
+				m_condition.notify_all ();
+			}
+		}
+
+		TaskGroup::TaskGroup (ThreadPool &_pool) : m_pool { _pool }
+		{}
+
+		TaskGroup::~TaskGroup ()
+		{
+			try
+			{
+				wait ();
+			}
+			catch (...)
+			{}
+		}
+
+		void TaskGroup::wait ()
+		{
+			while (true)
+			{
+				{
+					std::unique_lock<std::mutex> lock { m_mutex };
+					if (m_pendingCount == 0)
+					{
+						break;
+					}
+				}
+				if (!m_pool.tryRunTask ())
+				{
+					std::unique_lock<std::mutex> lock { m_mutex };
+					if (m_pool.isWorkerThread ())
+					{
+						// Wake up periodically to keep helping, since the remaining tasks may schedule nested ones on this worker
+						m_condition.wait_for (lock, std::chrono::milliseconds { 1 }, [this] () { return m_pendingCount == 0; });
+					}
+					else
+					{
+						// The workers never block while tasks are scheduled, so the remaining tasks will finish
+						m_condition.wait (lock, [this] () { return m_pendingCount == 0; });
+					}
+				}
+			}
+			std::exception_ptr error;
+			{
+				std::lock_guard<std::mutex> lock { m_mutex };
+				std::swap (error, m_error);
+			}
+			if (error)
+			{
+				std::rethrow_exception (error);
+			}
+		}
+
+	}
+
+}
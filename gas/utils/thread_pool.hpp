@@ -0,0 +1,210 @@
+/// GAS::Utils::ThreadPool work-stealing task scheduler.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_UTILS_THREAD_POOL_INCLUDED
+#define GAS_UTILS_THREAD_POOL_INCLUDED
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		class TaskGroup;
+
+		/// Fixed number of worker threads that run the scheduled tasks, meant to be shared by all the parallel operations.
+		/// Each worker owns a task deque: tasks scheduled by a worker are pushed to its own deque and run in LIFO order, so nested tasks
+		/// run while their data is still hot, while idle workers steal the oldest tasks from the other deques.
+		/// Tasks scheduled by other threads are distributed round-robin.
+		/// \remark
+		/// All the methods can be called concurrently, except for the destructor.
+		/// \remark
+		/// Deques are not bound to NUMA nodes nor workers to cores.
+		/// \see TaskGroup
+		/// \see parallelFor()
+		class ThreadPool final
+		{
+
+			friend class TaskGroup;
+
+			using Task = std::function<void ()>;
+
+			/// Task deque of a worker.
+			struct Queue
+			{
+				std::mutex mutex;
+				std::deque<Task> tasks;
+			};
+
+			/// Pool of the worker running on the calling thread, or \c nullptr.
+			static thread_local const ThreadPool *s_currentPool;
+
+			/// Queue index of the worker running on the calling thread.
+			static thread_local std::size_t s_currentQueue;
+
+			std::vector<std::unique_ptr<Queue>> m_queues;
+			std::vector<std::thread> m_workers;
+
+			/// Number of tasks in all the queues.
+			std::atomic<std::size_t> m_queuedCount;
+
+			/// Queue of the next task scheduled by a thread that is not a worker.
+			std::atomic<std::size_t> m_nextQueue;
+
+			/// Guards the sleeping of the idle workers.
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+			bool m_stopping {};
+
+			/// Worker thread loop.
+			/// \param[in] queue
+			/// The index of the queue owned by the worker.
+			void work (std::size_t queue);
+
+			/// Schedule a task.
+			/// \param[in] task
+			/// The task.
+			void push (Task task);
+
+			/// Take a task from a queue.
+			/// \param[in] queue
+			/// The queue index.
+			/// \param[in] newest
+			/// Whether to take the newest task instead of the oldest.
+			/// \param[out] task
+			/// The task, if any.
+			/// \return
+			/// \c true if a task has been taken, \c false if the queue is empty.
+			bool tryPop (std::size_t queue, bool newest, Task &task);
+
+			/// Run a scheduled task on the calling thread, preferring the queue of the calling worker.
+			/// \return
+			/// \c true if a task has been run, \c false if no task is scheduled.
+			bool tryRunTask ();
+
+			/// \return
+			/// \c true if the calling thread is a worker of this pool, \c false otherwise.
+			bool isWorkerThread () const;
+
+		public:
+
+			/// Construct a pool and start its workers.
+			/// \param[in] threadCount
+			/// The number of worker threads, or \c 0 to use one thread per hardware thread.
+			explicit ThreadPool (unsigned int threadCount = 0);
+
+			/// Run all the pending tasks and join the workers.
+			~ThreadPool ();
+
+			ThreadPool (const ThreadPool &) = delete;
+			ThreadPool &operator=(const ThreadPool &) = delete;
+
+			/// \return
+			/// The number of worker threads.
+			unsigned int threadCount () const;
+
+			/// Schedule a task.
+			/// \tparam Function
+			/// The callable type, invocable with no arguments.
+			/// \param[in] function
+			/// The task.
+			/// \return
+			/// The future result of \p function. Any exception thrown by \p function is stored in it.
+			/// \remark
+			/// A task waiting for a future blocks its worker. Use a TaskGroup to wait from inside a task.
+			template<class Function>
+			std::future<typename std::result_of<Function ()>::type> submit (Function &&function);
+
+		};
+
+		/// Set of tasks scheduled on a ThreadPool that can be waited for together.
+		/// \remark
+		/// A thread waiting for the group runs the scheduled tasks in the meantime, so tasks can wait for nested groups without exhausting the workers.
+		class TaskGroup final
+		{
+
+			ThreadPool &m_pool;
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+			std::size_t m_pendingCount {};
+			std::exception_ptr m_error;
+
+			/// Record the completion of a task.
+			/// \param[in] error
+			/// The exception thrown by the task, or \c nullptr.
+			void finish (std::exception_ptr error);
+
+		public:
+
+			/// Construct an empty group.
+			/// \param[in] pool
+			/// The pool running the tasks.
+			explicit TaskGroup (ThreadPool &pool);
+
+			/// Wait for the pending tasks, discarding their exceptions.
+			~TaskGroup ();
+
+			TaskGroup (const TaskGroup &) = delete;
+			TaskGroup &operator=(const TaskGroup &) = delete;
+
+			/// Schedule a task in the group.
+			/// \tparam Function
+			/// The callable type, copy constructible and invocable with no arguments.
+			/// \param[in] function
+			/// The task.
+			/// \exception std::bad_alloc
+			/// If the task cannot be scheduled, in which case it is not part of the group.
+			template<class Function>
+			void run (Function &&function);
+
+			/// Wait until all the tasks in the group have finished.
+			/// \exception std::exception
+			/// The first exception thrown by a task, if any. The other tasks still run to completion.
+			void wait ();
+
+		};
+
+		/// Call a function on consecutive chunks of a range, in parallel.
+		/// \tparam Index
+		/// An integral or random access iterator type.
+		/// \tparam Function
+		/// The callable type, invocable with the \c begin and \c end of a chunk.
+		/// \param[in] pool
+		/// The pool running the chunks.
+		/// \param[in] first
+		/// The \c begin of the range.
+		/// \param[in] last
+		/// The \c end of the range.
+		/// \param[in] function
+		/// The function to call on each chunk.
+		/// \param[in] chunkSize
+		/// The size of each chunk (except for the last one), or \c 0 to split the range into a few chunks per worker.
+		/// A nonzero size makes the chunks independent of the number of workers, so that per-chunk results are deterministic.
+		/// \exception std::exception
+		/// The first exception thrown by \p function, once all the chunks have finished.
+		/// \remark
+		/// The range is processed on the calling thread if it fits into a single chunk.
+		template<class Index, class Function>
+		void parallelFor (ThreadPool &pool, Index first, Index last, Function &&function, std::size_t chunkSize = 0);
+
+	}
+
+}
+
+#include "thread_pool.tpp"
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef GAS_UTILS_THREAD_POOL_IMPL_INCLUDED
+#define GAS_UTILS_THREAD_POOL_IMPL_INCLUDED
+
+#ifndef GAS_UTILS_THREAD_POOL_INCLUDED
+#error 'gas/utils/thread_pool.tpp' should not be directly included
+#endif
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		template<class Function>
+		std::future<typename std::result_of<Function ()>::type> ThreadPool::submit (Function &&_function)
+		{
+			using Result = typename std::result_of<Function ()>::type;
+			// std::function requires copyable targets
+			const std::shared_ptr<std::packaged_task<Result ()>> task { std::make_shared<std::packaged_task<Result ()>> (std::forward<Function> (_function)) };
+			std::future<Result> future { task->get_future () };
+			push ([task] () { (*task) (); });
+			return future;
+		}
+
+		template<class Function>
+		void TaskGroup::run (Function &&_function)
+		{
+			{
+				// Counted before the task becomes visible, so that it cannot finish first and make the count wrap
+				std::lock_guard<std::mutex> lock { m_mutex };
+				m_pendingCount++;
+			}
+			try
+			{
+				const typename std::decay<Function>::type function (std::forward<Function> (_function));
+				m_pool.push ([this, function] () {
+					std::exception_ptr error;
+					try
+					{
+						function ();
+					}
+					catch (...)
+					{
+						error = std::current_exception ();
+					}
+					finish (error);
+				});
+			}
+			catch (...)
+			{
+				// The task has not been scheduled, so it must not be waited for
+				finish (nullptr);
+				throw;
+			}
+		}
+
+		template<class Index, class Function>
+		void parallelFor (ThreadPool &_pool, Index _first, Index _last, Function &&_function, std::size_t _chunkSize)
+		{
+			if (!(_first < _last))
+			{
+				return;
+			}
+			const std::size_t count { static_cast<std::size_t>(_last - _first) };
+			if (_chunkSize == 0)
+			{
+				// A few chunks per worker, so that the stealing can balance uneven chunks
+				const std::size_t chunksCount { static_cast<std::size_t>(_pool.threadCount ()) * 4 };
+				_chunkSize = std::max<std::size_t> ((count + chunksCount - 1) / chunksCount, 1);
+			}
+			if (count <= _chunkSize)
+			{
+				_function (_first, _last);
+				return;
+			}
+			TaskGroup group { _pool };
+			for (std::size_t offset {}; offset < count; offset += _chunkSize)
+			{
+				const Index chunkFirst { static_cast<Index>(_first + offset) }, chunkLast { static_cast<Index>(_first + std::min (offset + _chunkSize, count)) };
+				group.run ([&_function, chunkFirst, chunkLast] () { _function (chunkFirst, chunkLast); });
+			}
+			group.wait ();
+		}
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,147 @@
+#include "tracing.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		namespace Tracing
+		{
+
+			namespace
+			{
+
+				/// Recorded complete event.
+				struct Event
+				{
+					const char *name;
+					std::chrono::steady_clock::time_point start, end;
+				};
+
+				/// Events recorded by a single thread.
+				struct Buffer
+				{
+					int thread;
+					std::vector<Event> events;
+				};
+
+				/// Time origin for the event timestamps.
+				const std::chrono::steady_clock::time_point s_origin { std::chrono::steady_clock::now () };
+
+				/// Guards #s_buffers.
+				std::mutex s_mutex;
+
+				/// All the thread buffers.
+				std::vector<std::unique_ptr<Buffer>> s_buffers;
+
+				/// \return
+				/// The calling thread buffer.
+				Buffer &getThreadBuffer ()
+				{
+					thread_local Buffer *buffer {};
+					if (!buffer)
+					{
+						std::lock_guard<std::mutex> lock { s_mutex };
+						s_buffers.emplace_back (new Buffer { static_cast<int>(s_buffers.size ()), {} });
+						buffer = s_buffers.back ().get ();
+					}
+					return *buffer;
+				}
+
+				/// \return
+				/// The microseconds elapsed from #s_origin to \p time.
+				double getTimestamp (std::chrono::steady_clock::time_point time)
+				{
+					return std::chrono::duration<double, std::micro> { time - s_origin }.count ();
+				}
+
+				/// Write \p string as a JSON string.
+				void writeString (std::ostream &_stream, const char *_string)
+				{
+					_stream << '"';
+					for (; *_string; _string++)
+					{
+						if (*_string == '"' || *_string == '\\')
+						{
+							_stream << '\\';
+						}
+						_stream << *_string;
+					}
+					_stream << '"';
+				}
+
+			}
+
+			Span::Span (const char *_name) : m_name { _name }, m_start { std::chrono::steady_clock::now () }
+			{}
+
+			Span::~Span ()
+			{
+				getThreadBuffer ().events.push_back ({ m_name, m_start, std::chrono::steady_clock::now () });
+			}
+
+			void write (std::ostream &_stream)
+			{
+				std::lock_guard<std::mutex> lock { s_mutex };
+				const std::ios_base::fmtflags flags { _stream.flags () };
+				const std::streamsize precision { _stream.precision () };
+				_stream << std::fixed << std::setprecision (3);
+				_stream << "{\"traceEvents\":[";
+				bool first { true };
+				for (const std::unique_ptr<Buffer> &buffer : s_buffers)
+				{
+					for (const Event &event : buffer->events)
+					{
+						if (!first)
+						{
+							_stream << ',';
+						}
+						first = false;
+						_stream << "{\"name\":";
+						writeString (_stream, event.name);
+						_stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->thread
+							<< ",\"ts\":" << getTimestamp (event.start)
+							<< ",\"dur\":" << getTimestamp (event.end) - getTimestamp (event.start) << '}';
+					}
+				}
+				_stream << "],\"displayTimeUnit\":\"ns\"}";
+				_stream.flags (flags);
+				_stream.precision (precision);
+			}
+
+			void save (const std::string &_filename)
+			{
+				std::ofstream file { _filename };
+				if (!file)
+				{
+					throw std::runtime_error ("Cannot open trace file");
+				}
+				write (file);
+				if (!file)
+				{
+					throw std::runtime_error ("Cannot write trace file");
+				}
+			}
+
+			void clear ()
+			{
+				std::lock_guard<std::mutex> lock { s_mutex };
+				for (const std::unique_ptr<Buffer> &buffer : s_buffers)
+				{
+					buffer->events.clear ();
+				}
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,93 @@
+/// GAS::Utils::Tracing span recorder for profiling purposes.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_UTILS_TRACING_INCLUDED
+#define GAS_UTILS_TRACING_INCLUDED
+
+#include <chrono>
+#include <ostream>
+#include <string>
+
+/// Enable the tracing spans placed through #GAS_UTILS_TRACE_SPAN.
+/// If not defined, #GAS_UTILS_TRACE_SPAN expands to nothing and the spans have no runtime cost.
+//#define GAS_UTILS_ENABLE_TRACING
+
+#define GAS_UTILS_TRACING_CONCAT_IMPL(a, b) a##b
+#define GAS_UTILS_TRACING_CONCAT(a, b) GAS_UTILS_TRACING_CONCAT_IMPL(a, b)
+
+/// Record a GAS::Utils::Tracing::Span that lasts until the end of the enclosing scope.
+/// \param[in] name
+/// The span name. Must be a string literal (or any string with static storage duration).
+#ifdef GAS_UTILS_ENABLE_TRACING
+#define GAS_UTILS_TRACE_SPAN(name) const GAS::Utils::Tracing::Span GAS_UTILS_TRACING_CONCAT(gasUtilsTracingSpan, __LINE__) { name }
+#else
+#define GAS_UTILS_TRACE_SPAN(name) ((void) 0)
+#endif
+
+namespace GAS
+{
+
+	namespace Utils
+	{
+
+		/// Scoped span recording in the Chrome trace event format.
+		/// Each thread records its spans in its own buffer, so recording never blocks.
+		/// \note
+		/// The output can be loaded in \c chrome://tracing or in any viewer supporting the trace event format.
+		namespace Tracing
+		{
+
+			/// Scoped span.
+			/// Records a complete event when destroyed.
+			class Span final
+			{
+
+				const char *m_name;
+				std::chrono::steady_clock::time_point m_start;
+
+			public:
+
+				/// Start a span.
+				/// \param[in] name
+				/// The span name.
+				/// \remark
+				/// A reference to \p name will be stored, so it must have static storage duration.
+				explicit Span (const char *name);
+
+				/// Stop the span and record it.
+				~Span ();
+
+				Span (const Span &) = delete;
+				Span &operator=(const Span &) = delete;
+
+			};
+
+			/// Write all the recorded spans as a Chrome trace event JSON object.
+			/// \param[in] stream
+			/// The output stream.
+			/// \pre
+			/// No span must be recording.
+			void write (std::ostream &stream);
+
+			/// Write all the recorded spans to a Chrome trace event JSON file.
+			/// \param[in] filename
+			/// The output file path.
+			/// \pre
+			/// No span must be recording.
+			/// \exception std::runtime_error
+			/// If the file cannot be written.
+			void save (const std::string &filename);
+
+			/// Discard all the recorded spans.
+			/// \pre
+			/// No span must be recording.
+			void clear ();
+
+		}
+
+	}
+
+}
+
+#endif
@@ -100,19 +100,16 @@ TrapezoidalMapManager::~TrapezoidalMapManager()
  */
 void TrapezoidalMapManager::addSegmentToTrapezoidalMap(const cg3::Segment2d& segment)
 {
-	try
-	{
-		m_trapezoidalMap.addSegment (segment);
-	}
-	catch (const std::invalid_argument & exception)
+	const GAS::EAddSegmentResult result { m_trapezoidalMap.tryAddSegment (segment) };
+	if (result != GAS::EAddSegmentResult::Added)
 	{
 		QMessageBox::warning (this, "Cannot insert segment",
-			QString { "Exception while inserting segment ((%1, %2), (%3, %4)):\n\"%5\".\nSegment will be ignored." }
+			QString { "Error while inserting segment ((%1, %2), (%3, %4)):\n\"%5\".\nSegment will be ignored." }
 			.arg (segment.p1 ().x ())
 			.arg (segment.p1 ().y ())
 			.arg (segment.p2 ().x ())
 			.arg (segment.p2 ().y ())
-			.arg (exception.what ()));
+			.arg (GAS::getAddSegmentResultMessage (result)));
 	}
 }
 
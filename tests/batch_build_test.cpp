@@ -0,0 +1,74 @@
+#include "test.hpp"
+
+#include <gas/data/trapezoidal_map_batch.hpp>
+#include <gas/utils/thread_pool.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace GAS
+{
+
+	namespace Tests
+	{
+
+		void testBatchBuild ()
+		{
+			// Long segments, so that many of them are rejected
+			std::vector<TrapezoidalMapTile<double>> tiles;
+			for (unsigned int i {}; i < 48; i++)
+			{
+				tiles.push_back ({ bottomLeft (), topRight (), randomSegments (400, i, 2e5) });
+			}
+			// Sequential reference
+			std::vector<Map> references;
+			std::vector<std::vector<EAddSegmentResult>> referenceResults;
+			for (const TrapezoidalMapTile<double> &tile : tiles)
+			{
+				Map reference { tile.bottomLeft, tile.topRight };
+				referenceResults.push_back (reference.tryAddSegments (tile.segments.begin (), tile.segments.end ()));
+				references.push_back (std::move (reference));
+			}
+			const std::vector<Point<double>> points { randomPoints (200, 0) };
+			// The outcome must not depend on the number of threads nor on their scheduling
+			for (const unsigned int threadsCount : { 1u, 2u, 8u })
+			{
+				Utils::ThreadPool pool { threadsCount };
+				for (int round {}; round < 3; round++)
+				{
+					const std::vector<TrapezoidalMapTileResult<double>> results { buildTrapezoidalMaps (tiles, pool) };
+					GAS_TESTS_CHECK (results.size () == tiles.size ());
+					for (std::size_t i {}; i < results.size (); i++)
+					{
+						const Map &map { *results[i].map };
+						GAS_TESTS_CHECK (results[i].results == referenceResults[i]);
+						GAS_TESTS_CHECK (map.segmentsCount () == references[i].segmentsCount ());
+						GAS_TESTS_CHECK (map.trapezoidsCount () == references[i].trapezoidsCount ());
+						for (const Point<double> &point : points)
+						{
+							const Trapezoid<double> &trapezoid { map.query (point) };
+							GAS_TESTS_CHECK (trapezoid.contains (point));
+							GAS_TESTS_CHECK (areTrapezoidsEqual (trapezoid, references[i].query (point)));
+						}
+					}
+				}
+			}
+			// A tile with invalid bounds fails the whole batch
+			tiles.push_back ({ topRight (), bottomLeft (), {} });
+			Utils::ThreadPool pool { 4 };
+			bool thrown {};
+			try
+			{
+				buildTrapezoidalMaps (tiles, pool);
+			}
+			catch (const std::invalid_argument &)
+			{
+				thrown = true;
+			}
+			GAS_TESTS_CHECK (thrown);
+		}
+
+	}
+
+}
@@ -0,0 +1,98 @@
+#include "test.hpp"
+
+#include <gas/data/concurrent_trapezoidal_map.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace GAS
+{
+
+	namespace Tests
+	{
+
+		void testConcurrentTrapezoidalMap ()
+		{
+			const std::vector<Segment<double>> segments { randomSegments (4000, 7) };
+			const std::vector<Point<double>> points { randomPoints (2000, 1) };
+			// A single thread must get the same outcome as a plain map
+			{
+				ConcurrentTrapezoidalMap<double> map { bottomLeft (), topRight () };
+				Map oracle { bottomLeft (), topRight () };
+				for (std::size_t i {}; i < segments.size (); i += 16)
+				{
+					const std::size_t last { std::min (i + 16, segments.size ()) };
+					const std::vector<EAddSegmentResult> results { map.tryAddSegments (segments.begin () + static_cast<std::ptrdiff_t>(i), segments.begin () + static_cast<std::ptrdiff_t>(last)) };
+					const std::vector<EAddSegmentResult> oracleResults { oracle.tryAddSegments (segments.begin () + static_cast<std::ptrdiff_t>(i), segments.begin () + static_cast<std::ptrdiff_t>(last)) };
+					GAS_TESTS_CHECK (results == oracleResults);
+				}
+				map.read ([&oracle] (const Map &_map) {
+					GAS_TESTS_CHECK (_map.trapezoidsCount () == oracle.trapezoidsCount ());
+				});
+			}
+			// Many threads, each adding interleaved batches, and single segments now and then
+			const int threadsCount { 4 };
+			const std::size_t batchSize { 16 };
+			ConcurrentTrapezoidalMap<double> map { bottomLeft (), topRight () };
+			std::vector<EAddSegmentResult> results (segments.size ());
+			std::vector<std::thread> threads;
+			for (int t {}; t < threadsCount; t++)
+			{
+				threads.emplace_back ([&map, &segments, &results, t, threadsCount, batchSize] () {
+					for (std::size_t i { static_cast<std::size_t>(t) * batchSize }; i < segments.size (); i += static_cast<std::size_t>(threadsCount) * batchSize)
+					{
+						const std::size_t last { std::min (i + batchSize, segments.size ()) };
+						if ((i / batchSize) % 5 == 0)
+						{
+							for (std::size_t s { i }; s < last; s++)
+							{
+								results[s] = map.tryAddSegment (segments[s]);
+							}
+						}
+						else
+						{
+							const std::vector<EAddSegmentResult> batch { map.tryAddSegments (segments.begin () + static_cast<std::ptrdiff_t>(i), segments.begin () + static_cast<std::ptrdiff_t>(last)) };
+							std::copy (batch.begin (), batch.end (), results.begin () + static_cast<std::ptrdiff_t>(i));
+						}
+					}
+				});
+			}
+			for (std::thread &thread : threads)
+			{
+				thread.join ();
+			}
+			map.read ([&segments, &points, &results] (const Map &_map) {
+				// The added segments, in the order they have been added, must be accepted by a plain map, which must end up identical
+				Map oracle { bottomLeft (), topRight () };
+				for (const Segment<double> &segment : _map.segments ())
+				{
+					GAS_TESTS_CHECK (oracle.tryAddSegment (segment) == EAddSegmentResult::Added);
+				}
+				GAS_TESTS_CHECK (oracle.trapezoidsCount () == _map.trapezoidsCount ());
+				for (const Point<double> &point : points)
+				{
+					const Trapezoid<double> &trapezoid { _map.query (point) };
+					GAS_TESTS_CHECK (trapezoid.contains (point));
+					GAS_TESTS_CHECK (areTrapezoidsEqual (trapezoid, oracle.query (point)));
+				}
+				// Each rejected segment must still be rejected by the final map
+				int addedCount {};
+				for (std::size_t i {}; i < segments.size (); i++)
+				{
+					if (results[i] == EAddSegmentResult::Added)
+					{
+						addedCount++;
+					}
+					else
+					{
+						GAS_TESTS_CHECK (_map.checkSegment (segments[i]) != EAddSegmentResult::Added);
+					}
+				}
+				GAS_TESTS_CHECK (addedCount == _map.segmentsCount ());
+			});
+		}
+
+	}
+
+}
@@ -0,0 +1,139 @@
+#include "test.hpp"
+
+#include <gas/data/epoch_trapezoidal_map.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace GAS
+{
+
+	namespace Tests
+	{
+
+		namespace
+		{
+
+			/// Query answered by a reader.
+			struct LoggedQuery
+			{
+				int segmentsCount;
+				Point<double> point;
+				Point<double> left, right;
+				Segment<double> bottom, top;
+			};
+
+		}
+
+		void testEpochTrapezoidalMap ()
+		{
+			const int readersCount { 4 };
+			const std::vector<Segment<double>> segments { randomSegments (1500, 5) };
+			EpochTrapezoidalMap<double> map { bottomLeft (), topRight (), readersCount };
+			std::atomic<bool> done { false };
+			std::atomic<int> startedReadersCount { 0 };
+			std::vector<std::vector<LoggedQuery>> logs (readersCount);
+			std::vector<std::thread> readers;
+			for (int r {}; r < readersCount; r++)
+			{
+				readers.emplace_back ([&map, &done, &startedReadersCount, &logs, r] () {
+					std::vector<LoggedQuery> &log { logs[static_cast<std::size_t>(r)] };
+					// Keep a bounded log spread over the whole run, by halving it and logging half as often whenever it is full
+					const std::size_t maxLogSize { 1 << 14 };
+					log.reserve (maxLogSize);
+					unsigned long long queriesCount {}, logStride { 1 };
+					startedReadersCount++;
+					std::mt19937 generator { static_cast<unsigned int>(r) };
+					std::uniform_real_distribution<double> coordinate { bottomLeft ().x () + 1, topRight ().x () - 1 };
+					while (!done.load ())
+					{
+						const EpochTrapezoidalMap<double>::Reader reader { map };
+						const int segmentsCount { reader->segmentsCount () };
+						for (int i {}; i < 16; i++)
+						{
+							const double x { coordinate (generator) }, y { coordinate (generator) };
+							const Point<double> point { x, y };
+							const Trapezoid<double> &trapezoid { reader->query (point) };
+							if (queriesCount++ % logStride)
+							{
+								continue;
+							}
+							log.push_back ({ segmentsCount, point, *trapezoid.left (), *trapezoid.right (), *trapezoid.bottom (), *trapezoid.top () });
+							if (log.size () == maxLogSize)
+							{
+								for (std::size_t l {}; l < maxLogSize / 2; l++)
+								{
+									log[l] = log[l * 2];
+								}
+								log.resize (maxLogSize / 2);
+								logStride *= 2;
+							}
+						}
+						// The published map cannot change while it is being read
+						GAS_TESTS_CHECK (reader->segmentsCount () == segmentsCount);
+					}
+				});
+			}
+			// Start writing only when all the readers are running
+			while (startedReadersCount.load () < readersCount)
+			{
+				std::this_thread::yield ();
+			}
+			// Add the segments both one by one and in batches
+			std::vector<EAddSegmentResult> results;
+			const std::size_t half { segments.size () / 2 };
+			for (std::size_t i {}; i < half; i++)
+			{
+				results.push_back (map.tryAddSegment (segments[i]));
+			}
+			for (std::size_t i { half }; i < segments.size (); i += 50)
+			{
+				const std::size_t last { std::min (i + 50, segments.size ()) };
+				const std::vector<EAddSegmentResult> batch { map.tryAddSegments (segments.begin () + static_cast<std::ptrdiff_t>(i), segments.begin () + static_cast<std::ptrdiff_t>(last)) };
+				results.insert (results.end (), batch.begin (), batch.end ());
+			}
+			done.store (true);
+			for (std::thread &reader : readers)
+			{
+				reader.join ();
+			}
+			// Replay the segments on a sequential oracle, checking each query against the oracle with as many segments as the reader saw
+			std::vector<LoggedQuery> queries;
+			for (const std::vector<LoggedQuery> &log : logs)
+			{
+				queries.insert (queries.end (), log.begin (), log.end ());
+			}
+			std::sort (queries.begin (), queries.end (), [] (const LoggedQuery &_a, const LoggedQuery &_b) {
+				return _a.segmentsCount < _b.segmentsCount;
+			});
+			GAS_TESTS_CHECK (!queries.empty ());
+			Map oracle { bottomLeft (), topRight () };
+			std::vector<EAddSegmentResult> oracleResults;
+			std::size_t next {};
+			for (const LoggedQuery &query : queries)
+			{
+				while (oracle.segmentsCount () < query.segmentsCount && next < segments.size ())
+				{
+					oracleResults.push_back (oracle.tryAddSegment (segments[next++]));
+				}
+				GAS_TESTS_CHECK (oracle.segmentsCount () == query.segmentsCount);
+				const Trapezoid<double> &trapezoid { oracle.query (query.point) };
+				GAS_TESTS_CHECK (*trapezoid.left () == query.left && *trapezoid.right () == query.right);
+				GAS_TESTS_CHECK (*trapezoid.bottom () == query.bottom && *trapezoid.top () == query.top);
+			}
+			while (next < segments.size ())
+			{
+				oracleResults.push_back (oracle.tryAddSegment (segments[next++]));
+			}
+			GAS_TESTS_CHECK (results == oracleResults);
+			const EpochTrapezoidalMap<double>::Reader reader { map };
+			GAS_TESTS_CHECK (reader->segmentsCount () == oracle.segmentsCount ());
+			GAS_TESTS_CHECK (reader->trapezoidsCount () == oracle.trapezoidsCount ());
+		}
+
+	}
+
+}
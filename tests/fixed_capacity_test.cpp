@@ -0,0 +1,172 @@
+#include "test.hpp"
+
+#include <gas/utils/memory_resource.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+	/// Number of calls to the global allocation functions, which count the allocations that bypass the memory resource.
+	std::atomic<long long> s_globalAllocationsCount { 0 };
+
+}
+
+void *operator new (std::size_t _size)
+{
+	s_globalAllocationsCount.fetch_add (1, std::memory_order_relaxed);
+	void *const pointer { std::malloc (_size ? _size : 1) };
+	if (!pointer)
+	{
+		throw std::bad_alloc {};
+	}
+	return pointer;
+}
+
+void *operator new[] (std::size_t _size)
+{
+	return operator new (_size);
+}
+
+void operator delete (void *_pointer) noexcept
+{
+	std::free (_pointer);
+}
+
+void operator delete[] (void *_pointer) noexcept
+{
+	std::free (_pointer);
+}
+
+namespace GAS
+{
+
+	namespace Tests
+	{
+
+		namespace
+		{
+
+			/// Counters of both the global allocation functions and a tracking resource.
+			struct AllocationsSnapshot
+			{
+				long long globalAllocationsCount;
+				std::size_t resourceAllocationsCount, resourceBytesInUse;
+			};
+
+			AllocationsSnapshot takeSnapshot (const Utils::TrackingResource &_resource)
+			{
+				return { s_globalAllocationsCount.load (), _resource.allocationsCount (), _resource.bytesInUse () };
+			}
+
+			bool hasAllocated (const AllocationsSnapshot &_snapshot, const Utils::TrackingResource &_resource)
+			{
+				const AllocationsSnapshot current { takeSnapshot (_resource) };
+				return current.globalAllocationsCount != _snapshot.globalAllocationsCount
+					|| current.resourceAllocationsCount != _snapshot.resourceAllocationsCount
+					|| current.resourceBytesInUse != _snapshot.resourceBytesInUse;
+			}
+
+		}
+
+		void testFixedCapacity ()
+		{
+			const int segmentsCapacity { 2000 };
+			// More segments than the capacity, so that some of them are rejected for exceeding it
+			const std::vector<Segment<double>> segments { randomSegments (segmentsCapacity * 3, 11) };
+			const std::vector<Point<double>> points { randomPoints (5000, 3) };
+			std::vector<Segment<double>> added;
+			added.reserve (segments.size ());
+			Utils::TrackingResource resource;
+			{
+				Map map { bottomLeft (), topRight (), TrapezoidalMapCapacity { segmentsCapacity, segmentsCapacity * 8 }, resource };
+				GAS_TESTS_CHECK (map.hasFixedCapacity () && map.capacity ().segments == segmentsCapacity);
+				// Inserting and querying must not allocate anything
+				const AllocationsSnapshot snapshot { takeSnapshot (resource) };
+				int capacityExceededCount {};
+				Map::InsertionHint hint;
+				for (std::size_t i {}; i < segments.size (); i++)
+				{
+					const EAddSegmentResult result { i % 2 ? map.tryAddSegment (segments[i]) : map.tryAddSegment (segments[i], hint) };
+					if (result == EAddSegmentResult::Added)
+					{
+						added.push_back (segments[i]);
+					}
+					else if (result == EAddSegmentResult::CapacityExceeded)
+					{
+						capacityExceededCount++;
+					}
+				}
+				int wrongQueriesCount {};
+				for (const Point<double> &point : points)
+				{
+					if (!map.query (point).contains (point))
+					{
+						wrongQueriesCount++;
+					}
+				}
+				GAS_TESTS_CHECK (!hasAllocated (snapshot, resource));
+				GAS_TESTS_CHECK (capacityExceededCount > 0);
+				GAS_TESTS_CHECK (wrongQueriesCount == 0);
+				GAS_TESTS_CHECK (map.segmentsCount () == static_cast<int>(added.size ()));
+				// Rejecting for capacity must not alter the outcome of the accepted segments
+				Map reference { bottomLeft (), topRight () };
+				for (const Segment<double> &segment : added)
+				{
+					reference.addSegment (segment);
+				}
+				GAS_TESTS_CHECK (reference.trapezoidsCount () == map.trapezoidsCount ());
+				// Clearing keeps the storage, so refilling does not allocate either
+				const AllocationsSnapshot refillSnapshot { takeSnapshot (resource) };
+				map.clear ();
+				for (const Segment<double> &segment : added)
+				{
+					map.addSegmentUnchecked (segment);
+				}
+				GAS_TESTS_CHECK (!hasAllocated (refillSnapshot, resource));
+				GAS_TESTS_CHECK (map.trapezoidsCount () == reference.trapezoidsCount ());
+				// Copies keep the capacity
+				Map copy { map };
+				GAS_TESTS_CHECK (copy.hasFixedCapacity () && copy.capacity ().nodes == segmentsCapacity * 8);
+				const AllocationsSnapshot copySnapshot { takeSnapshot (resource) };
+				copy.clear ();
+				for (const Segment<double> &segment : added)
+				{
+					copy.addSegment (segment);
+				}
+				GAS_TESTS_CHECK (!hasAllocated (copySnapshot, resource));
+			}
+			GAS_TESTS_CHECK (resource.bytesInUse () == 0);
+			// A segment rejected for lack of nodes must leave the map unchanged
+			Map small { bottomLeft (), topRight (), TrapezoidalMapCapacity { segmentsCapacity, 50 } };
+			for (const Segment<double> &segment : segments)
+			{
+				const int trapezoidsCount { small.trapezoidsCount () };
+				if (small.tryAddSegment (segment) != EAddSegmentResult::Added)
+				{
+					GAS_TESTS_CHECK (small.trapezoidsCount () == trapezoidsCount);
+				}
+			}
+			for (const Point<double> &point : points)
+			{
+				GAS_TESTS_CHECK (small.query (point).contains (point));
+			}
+			bool thrown {};
+			try
+			{
+				const Map invalid { bottomLeft (), topRight (), TrapezoidalMapCapacity { 1, 0 } };
+			}
+			catch (const std::invalid_argument &)
+			{
+				thrown = true;
+			}
+			GAS_TESTS_CHECK (thrown);
+		}
+
+	}
+
+}
@@ -0,0 +1,42 @@
+#include "test.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
+namespace
+{
+
+	/// Named test.
+	struct Test
+	{
+		const char *name;
+		void (*run) ();
+	};
+
+}
+
+int main ()
+{
+	using namespace GAS::Tests;
+	const Test tests[] {
+		{ "batch build", &testBatchBuild },
+		{ "epoch trapezoidal map", &testEpochTrapezoidalMap },
+		{ "concurrent trapezoidal map", &testConcurrentTrapezoidalMap },
+		{ "fixed capacity", &testFixedCapacity },
+	};
+	for (const Test &test : tests)
+	{
+		std::cout << "Running " << test.name << std::endl;
+		try
+		{
+			test.run ();
+		}
+		catch (const std::exception &exception)
+		{
+			check (false, exception.what (), test.name, 0);
+		}
+	}
+	std::cout << failuresCount () << " failed checks" << std::endl;
+	return failuresCount () ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+#include "test.hpp"
+
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include <random>
+
+namespace GAS
+{
+
+	namespace Tests
+	{
+
+		namespace
+		{
+
+			/// Guards the standard error stream.
+			std::mutex s_mutex;
+
+			std::atomic<int> s_failuresCount { 0 };
+
+		}
+
+		void check (bool _condition, const char *_expression, const char *_file, int _line)
+		{
+			if (!_condition)
+			{
+				s_failuresCount.fetch_add (1, std::memory_order_relaxed);
+				const std::lock_guard<std::mutex> lock { s_mutex };
+				std::cerr << _file << ":" << _line << ": check failed: " << _expression << std::endl;
+			}
+		}
+
+		int failuresCount ()
+		{
+			return s_failuresCount.load (std::memory_order_relaxed);
+		}
+
+		Point<double> bottomLeft ()
+		{
+			return { -1e6, -1e6 };
+		}
+
+		Point<double> topRight ()
+		{
+			return { 1e6, 1e6 };
+		}
+
+		std::vector<Segment<double>> randomSegments (int _count, unsigned int _seed, double _maxLength)
+		{
+			std::mt19937 generator { _seed };
+			// Keep the endpoints inside the bounds
+			std::uniform_real_distribution<double> coordinate { bottomLeft ().x () + _maxLength, topRight ().x () - _maxLength }, offset { -_maxLength, _maxLength };
+			std::vector<Segment<double>> segments;
+			segments.reserve (static_cast<std::size_t>(_count));
+			for (int i {}; i < _count; i++)
+			{
+				const double x { coordinate (generator) }, y { coordinate (generator) };
+				const double dx { offset (generator) }, dy { offset (generator) };
+				segments.push_back ({ { x, y }, { x + dx, y + dy } });
+			}
+			return segments;
+		}
+
+		std::vector<Point<double>> randomPoints (int _count, unsigned int _seed)
+		{
+			std::mt19937 generator { _seed };
+			std::uniform_real_distribution<double> coordinate { bottomLeft ().x () + 1, topRight ().x () - 1 };
+			std::vector<Point<double>> points;
+			points.reserve (static_cast<std::size_t>(_count));
+			for (int i {}; i < _count; i++)
+			{
+				const double x { coordinate (generator) }, y { coordinate (generator) };
+				points.push_back ({ x, y });
+			}
+			return points;
+		}
+
+		bool areTrapezoidsEqual (const Trapezoid<double> &_a, const Trapezoid<double> &_b)
+		{
+			return *_a.left () == *_b.left () && *_a.right () == *_b.right () && *_a.bottom () == *_b.bottom () && *_a.top () == *_b.top ();
+		}
+
+	}
+
+}
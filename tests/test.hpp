@@ -0,0 +1,95 @@
+/// Minimal harness shared by the GAS stress tests.
+/// \file
+/// \author Francesco Zoccheddu
+
+#ifndef GAS_TESTS_TEST_INCLUDED
+#define GAS_TESTS_TEST_INCLUDED
+
+#include <gas/data/point.hpp>
+#include <gas/data/segment.hpp>
+#include <gas/data/trapezoid.hpp>
+#include <gas/data/trapezoidal_map.hpp>
+#include <vector>
+
+/// Record a failure if \p condition is false, without stopping the test.
+#define GAS_TESTS_CHECK(condition) ::GAS::Tests::check ((condition), #condition, __FILE__, __LINE__)
+
+namespace GAS
+{
+
+	/// Stress tests run by the \c tests qmake project.
+	namespace Tests
+	{
+
+		using Map = TrapezoidalMap<double>;
+
+		/// Record a failure if \p condition is false.
+		/// Can be called by many threads at once.
+		/// \param[in] condition
+		/// The checked condition.
+		/// \param[in] expression
+		/// The source code of \p condition.
+		/// \param[in] file
+		/// The source file of the check.
+		/// \param[in] line
+		/// The source line of the check.
+		void check (bool condition, const char *expression, const char *file, int line);
+
+		/// \return
+		/// The number of failed checks so far.
+		int failuresCount ();
+
+		/// \return
+		/// The bottom left corner of the maps used by the tests.
+		Point<double> bottomLeft ();
+
+		/// \return
+		/// The top right corner of the maps used by the tests.
+		Point<double> topRight ();
+
+		/// Generate random segments inside the test bounds, some of which are intersecting or degenerate.
+		/// \param[in] count
+		/// The number of segments.
+		/// \param[in] seed
+		/// The seed of the generator.
+		/// \param[in] maxLength
+		/// The maximum extent of each segment along each axis.
+		/// \return
+		/// The segments, always the same for the same arguments.
+		std::vector<Segment<double>> randomSegments (int count, unsigned int seed, double maxLength = 5e4);
+
+		/// Generate random points strictly inside the test bounds.
+		/// \param[in] count
+		/// The number of points.
+		/// \param[in] seed
+		/// The seed of the generator.
+		/// \return
+		/// The points, always the same for the same arguments.
+		std::vector<Point<double>> randomPoints (int count, unsigned int seed);
+
+		/// \param[in] a
+		/// The first trapezoid.
+		/// \param[in] b
+		/// The second trapezoid, possibly belonging to another map.
+		/// \return
+		/// \c true if the two trapezoids have the same boundaries, \c false otherwise.
+		bool areTrapezoidsEqual (const Trapezoid<double> &a, const Trapezoid<double> &b);
+
+		/// Build many maps at once with buildTrapezoidalMaps() and compare them with the same maps built sequentially.
+		void testBatchBuild ();
+
+		/// Query an EpochTrapezoidalMap from many threads while a writer adds segments, and check every answer against a sequential oracle.
+		void testEpochTrapezoidalMap ();
+
+		/// Add segments to a ConcurrentTrapezoidalMap from many threads, and check that the outcome is one that a sequential map could have produced.
+		void testConcurrentTrapezoidalMap ();
+
+		/// Check that a map with a fixed capacity adds segments, clears and answers queries without allocating, counting both the allocations
+		/// through its Utils::TrackingResource and the calls to the global allocation functions.
+		void testFixedCapacity ();
+
+	}
+
+}
+
+#endif
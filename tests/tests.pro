@@ -0,0 +1,42 @@
+# Stress tests of the GAS library.
+# Run them with "make check", after running "qmake CONFIG+=tsan" to build them with ThreadSanitizer.
+
+TEMPLATE = app
+TARGET = gas_tests
+
+CONFIG += console testcase
+CONFIG -= app_bundle
+
+# cg3lib works with c++11
+CONFIG += c++11
+
+# Only the geometry primitives are needed
+CONFIG += CG3_CORE
+
+# Include the chosen modules
+include (../cg3lib/cg3.pri)
+
+INCLUDEPATH += ..
+
+# ThreadSanitizer configuration
+tsan {
+    QMAKE_CXXFLAGS += -fsanitize=thread -g
+    QMAKE_LFLAGS += -fsanitize=thread
+}
+
+SOURCES += \
+    ../gas/utils/epoch.cpp \
+    ../gas/utils/memory_resource.cpp \
+    ../gas/utils/serial.cpp \
+    ../gas/utils/shared_mutex.cpp \
+    ../gas/utils/thread_pool.cpp \
+    ../gas/utils/tracing.cpp \
+    batch_build_test.cpp \
+    concurrent_trapezoidal_map_test.cpp \
+    epoch_trapezoidal_map_test.cpp \
+    fixed_capacity_test.cpp \
+    main.cpp \
+    test.cpp
+
+HEADERS += \
+    test.hpp